@@ -2,11 +2,48 @@
 
 #import <Cocoa/Cocoa.h>
 #include <Foundation/NSLock.h>
+#include <pthread.h>
+#include "tsring.h"
+#include "cwslot.h"
+#include "tsbatch.h"
+#include "sectionGate.h"
+#include "descrambler.h"
+#include "statistics.h"
+#include "coarseClock.h"
 
 #define MAX_DEVICES 16
 
+// per PID flags, see -pidFlags
+#define PID_COUNT            8192
+#define PID_FLAG_SEND        0x01  // forward the packets to the daemon (ECM, EMM, ...)
+#define PID_FLAG_DESCRAMBLE  0x02  // descramble the packets
+#define PID_FLAG_NEW_GATE    0x04  // forget the sections sent of the PID, see -addPid:
+
+// services descrambled at once per device, each with its own control words
+#define KEY_CONTEXTS         4
+
+typedef struct
+{
+  void *keys;
+  unsigned long service;        // EyeTV service id, 0 = free
+  unsigned char even_dw[8];
+  unsigned char odd_dw[8];
+  volatile bool descramble;     // has control words, see -descrambleMask for their age
+  volatile uint32_t dwTick;     // coarseTick of the last control words
+  volatile uint32_t validUntil; // coarseTick the words expire at
+  volatile uint32_t dwSeq;      // counts the control words, see -descramblePackets:
+} keyContext;
+
+#define CW_TIMEOUT     60000      // milliseconds a control word is used without a new one
+#define PARITY_SETTLE  1000       // milliseconds the PIDs of a service may take to change parity together
+
+// log the device statistics every 10 seconds
 //#define SHOW_SPEED_STATISTICS
 
+// share the decryption with a worker thread per device, see descrambler.h;
+// without it the packet callback decrypts on its own
+#define DESCRAMBLER_THREAD
+
 /*
 @interface NSCondition : NSObject <NSLocking> {                                                   
 @private                                                                                          
@@ -27,56 +64,78 @@
 @interface Controller : NSObject
 {
 	@private
-	NSMutableIndexSet *pidList;
-	void *keys;
-	bool doDescramble;
-	NSMutableArray *tsPackets;
-	NSMutableArray *cleanPackets;
+	volatile unsigned char pidFlags[PID_COUNT];
+	volatile unsigned char pidContext[PID_COUNT];	// key context of a PID_FLAG_DESCRAMBLE PID
+	keyContext contexts[KEY_CONTEXTS];
+	void *contextKeys[KEY_CONTEXTS];	// contexts[i].keys, as the decrypt calls want them
+	int currentContext;		// the service EyeTV changed to last
+	descrambler *worker;		// NULL: the packet callback decrypts on its own
 	NSLock *dataLock;
-	NSLock *descramblerLock;
-	NSTimeInterval lastDwTime;
-	NSMutableIndexSet *decryptPids;
 	int deviceIndex;
+	tsring ring;		// to the daemon, see tsring.h
+	bool ringOpen;
+	pthread_mutex_t ringLock;	// one producer at a time: packet thread, service changes, messages
+	cwSlot cws;			// control words from the daemon, see cwslot.h
+	bool cwsOpen;
+	uint32_t cwsSeq;		// last sequence read from cws
+	sectionGate **gates;		// per PID, PID_FLAG_SEND PIDs only, packet thread only
+	volatile uint32_t gatesGeneration;	// bumped to have the packet thread clear the gates
+	uint32_t gatesSeen;
 	NSDate *lastCheck;
 	unsigned int tspc;
 
 	int packetsBlockCount;
-	unsigned char even_dw[8];
-	unsigned char odd_dw[8];
 	
-#ifdef SHOW_SPEED_STATISTICS
-	CFAbsoluteTime		speedStatisticsLastOutput;
-	CFTimeInterval		speedStatisticsDuration;
-	long				speedStatisticsPackets;
-	long				speedStatisticsClusters;
-#endif
+	// statistics, see statistics.h; the packet thread writes them
+	volatile uint32_t statSeq;	// for the two below, see countersWriteBegin
+	volatile uint64_t statPackets;
+	volatile uint64_t statScrambled;
+	decryptCounters counters;	// the packet callback's decryption
+	volatile uint32_t parityTick;	// coarseTick of the last parity change
+	volatile bool parityChanged;	// parityTick is set
+
+	// parity changes by key context, packet thread only
+	int contextParity[KEY_CONTEXTS];	// 0x80 even, 0xc0 odd, 0 none seen yet
+	uint32_t flipTick[KEY_CONTEXTS];	// coarseTick of the last change
+	uint32_t flipSeq[KEY_CONTEXTS];		// dwSeq at the last change
+	unsigned int staleMask;			// changed parity twice on the same words
 
 }
 
 + (void)LaunchThread:(id)obj;
-- (void)descramblerEvent:(NSTimer *)timerObj;
 - (void)pidFilterEvent:(NSTimer *)timerObj;
+- (void)clockEvent:(NSTimer *)timerObj;
 - (id)init;
 - (void)dealloc;
 - (void)logMessage:( NSString *)msg;
 - (void)sendData:(NSArray *)parray;
+- (void)sendPacket:(const unsigned char *)bytes length:(int)len;
+- (void)sendSectionPacket:(const unsigned char *)pkt info:(const tsPacketInfo *)info;
+- (void)resetSections;
 - (void)clearPidList;
 - (void)clearDescramblerPidList;
+- (const volatile unsigned char *)pidFlags;
 - (bool)isPidInList:(unsigned int)pid;
 - (bool)isPidInDescramblerList:(unsigned int)pid;
 - (void)addPid:(unsigned int)pid;
-- (void)addPidToDescrambler:(unsigned int)pid;
+- (void)addPidToDescrambler:(unsigned int)pid context:(int)ctx;
 - (void)removePid:(unsigned int)pid;
-- (bool)descramble;
-- (void)setDescramble:(bool)action;
+- (const volatile unsigned char *)pidContexts;
+- (int)keyContextForService:(unsigned long)service;
+- (void)clearKeyContexts;
+- (unsigned int)descrambleMask;
+- (void)setDescramble:(bool)action context:(int)ctx;
 - (void *)getKeys;
-- (void)appendTsPacket:(unsigned char *)pbytes length:(int)len;
-- (void)getCleanTsPacket:(unsigned char *)buffer;
+- (void)countPackets:(int)count;
+- (void)descramblePackets:(unsigned char **)pkts keys:(const int *)keyIndex count:(int)count;
+- (void)statistics:(deviceStatistics *)stats;
 - (void)channelChange;
 - (void)setDevIndex:(int)index;
 - (int)getDevIndex;
 - (void)rcvPidsAndControls:(NSNotification *)obj;
 - (void)decodeCwdwgwMessage:(NSData *)pmsg;
+- (void)applyControlWords:(unsigned char *)dw service:(unsigned long)service;
+- (void)pollControlWords;
 @end
 
 static inline void pluginLog(const char *format, ...)
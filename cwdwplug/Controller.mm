@@ -3,36 +3,8 @@
 #include "FFdecsa/FFdecsa.h"
 #include "EyeTVPluginDefs.h"
 #include <stdlib.h>
-typedef struct
-{                                                                                                                                          
-#if defined(__BIG_ENDIAN__)                                                                                                                
-  unsigned int  syncByte:8,                                                                                                                 
-	    transportErr:1,                                                                                                             
-	    payloadStart:1,                                                                                                             
-	    priority:1,                                                                                                                 
-	    pid:13,                                                                                                                     
-	    scrambling:2,                                                                                                               
-	    adaption:2,                                                                                                                 
-	    continuity:4;                                                                                                               
-#endif                                                                                                                                     
-#if defined(__LITTLE_ENDIAN__)                                                                                                             
-  unsigned int syncByte:8,
-		  transportErr:1,                                                                                                             
-		  payloadStart:1,                                                                                                             
-		  priority:1,                                                                                                                 
-		  pid:13,                                                                                                                     
-		  scrambling:2,                                                                                                               
-		  adaption:2,                                                                                                                 
-          continuity:4;                                                                                                                 
-#endif                                                                                                                                     
-} TSFields;                                                                                                                                
-
-typedef union                                                                                                                              
-{                                                                                                                                          
-  TSFields ts;                                                                                                                             
-  unsigned int word;                                                                                                                       
-} TSHeader;
 static bool doExit = NO;
+volatile uint32_t coarseTick = 0;
 extern NSCondition *pidFilter[MAX_DEVICES];
 
 @implementation Controller
@@ -42,28 +14,42 @@ extern NSCondition *pidFilter[MAX_DEVICES];
 	self = [super init];
 	if (self != nil)
 	{
-		lastDwTime = [[NSDate date] timeIntervalSince1970];
-		tsPackets = [[NSMutableArray alloc] init];
-		cleanPackets = [[NSMutableArray alloc] init];
 		dataLock = [[NSLock alloc] init];
-		descramblerLock = [[NSLock alloc] init];
-		decryptPids = [[NSMutableIndexSet alloc] init];
-		doDescramble = NO;
-		keys = get_key_struct();
-		pidList = [[NSMutableIndexSet alloc] init];
+		pthread_mutex_init(&ringLock, NULL);
+		uint32_t tick = coarseClockUpdate();
+		memset(contexts, 0, sizeof(contexts));
+		for(int i = 0; i < KEY_CONTEXTS; i++)
+		{
+		  contexts[i].keys = contextKeys[i] = get_key_struct();
+		  contexts[i].dwTick = tick;
+		  contexts[i].validUntil = tick;
+		}
+		currentContext = 0;
+		memset((void *)pidFlags, 0, sizeof(pidFlags));
+		memset((void *)pidContext, 0, sizeof(pidContext));
+		gates = (sectionGate **)calloc(PID_COUNT, sizeof(sectionGate *));
+		gatesGeneration = 0;
+		gatesSeen = 0;
 		lastCheck = [[NSDate alloc] init];
 		tspc = 0;
 		packetsBlockCount = get_internal_parallelism();
-		
-		memset(even_dw, 0, sizeof(even_dw));
-		memset(odd_dw, 0, sizeof(odd_dw));
-		
-#ifdef SHOW_SPEED_STATISTICS
-		speedStatisticsLastOutput = 0.;
-		speedStatisticsDuration = 0.;
-		speedStatisticsPackets = 0;
-		speedStatisticsClusters = 0;
+		worker = NULL;
+#ifdef DESCRAMBLER_THREAD
+		// a single core has no one to share with
+		if( sysconf(_SC_NPROCESSORS_ONLN) > 1 )
+		  worker = descramblerNew(contextKeys, KEY_CONTEXTS, packetsBlockCount);
 #endif
+		
+		statSeq = 0;
+		statPackets = 0;
+		statScrambled = 0;
+		memset((void *)&counters, 0, sizeof(counters));
+		parityTick = 0;
+		parityChanged = false;
+		memset(contextParity, 0, sizeof(contextParity));
+		memset(flipTick, 0, sizeof(flipTick));
+		memset(flipSeq, 0, sizeof(flipSeq));
+		staleMask = 0;
 	}
 	return self;
 }
@@ -71,33 +57,156 @@ extern NSCondition *pidFilter[MAX_DEVICES];
 - (void) dealloc 
 {
   [dataLock release];
-  [descramblerLock release];
-  [cleanPackets release];
-  [tsPackets release];
-  [pidList release];
-  [decryptPids release];
-  free_key_struct(keys);
+  if( ringOpen == true )
+    tsringClose(&ring);
+  pthread_mutex_destroy(&ringLock);
+  if( cwsOpen == true )
+    cwSlotClose(&cws);
+  descramblerFree(worker);
+  for(int i = 0; i < KEY_CONTEXTS; i++)
+    free_key_struct(contexts[i].keys);
+  for(unsigned int pid = 0; pid < PID_COUNT; pid++)
+    sectionGateFree(gates[pid]);
+  free(gates);
   [super dealloc];
 }
 
-- (bool)descramble
+/* The contexts that have fresh control words, one bit each, for the packet
+ * thread once per batch. Words older than CW_TIMEOUT stop descrambling;
+ * that takes a load of coarseTick and a compare per context. So do words
+ * the service changed parity twice on, the daemon no longer follows it (see
+ * -descramblePackets:), until new ones come. The context itself is left to
+ * the threads holding dataLock, a refresh racing with the expiry just
+ * misses a batch. */
+- (unsigned int)descrambleMask
 {
-  NSTimeInterval curInterval = [[NSDate date] timeIntervalSince1970];
-  if( (curInterval - lastDwTime) >= 60 )
+  uint32_t tick = coarseTick;
+  unsigned int mask = 0;
+  for(int i = 0; i < KEY_CONTEXTS; i++)
   {
-    doDescramble = NO;
+    if( (staleMask & (1 << i)) && contexts[i].dwSeq != flipSeq[i] )
+      staleMask &= ~(1 << i);
+    if( contexts[i].descramble == YES && !coarseTickReached(tick, contexts[i].validUntil) && !(staleMask & (1 << i)) )
+      mask |= 1 << i;
   }
-  return doDescramble;
+  return mask;
 }
 
-- (void)setDescramble:(bool)action
+// with dataLock held
+- (void)setDescramble:(bool)action context:(int)ctx
 {
-  doDescramble = action;
+  contexts[ctx].descramble = action;
 }
 
 - (void *)getKeys
 {
-  return keys;
+  return contexts[currentContext].keys;
+}
+
+/* The key context of a service, a free one or the one that went longest
+ * without control words when it's new; its PIDs are taken from the
+ * descrambler. It becomes the current one, for control words that don't
+ * say which service they are for. */
+- (int)keyContextForService:(unsigned long)service
+{
+  int ctx = -1;
+  [dataLock lock];
+  for(int i = 0; i < KEY_CONTEXTS && ctx < 0; i++)
+  {
+    if( contexts[i].service == service )
+      ctx = i;
+  }
+  if( ctx < 0 )
+  {
+    ctx = 0;
+    for(int i = 1; i < KEY_CONTEXTS; i++)
+    {
+      if( contexts[ctx].service != 0 && (contexts[i].service == 0 || (int32_t)(contexts[i].dwTick - contexts[ctx].dwTick) < 0) )
+	ctx = i;
+    }
+    for(unsigned int pid = 0; pid < PID_COUNT; pid++)
+    {
+      if( (pidFlags[pid] & PID_FLAG_DESCRAMBLE) && pidContext[pid] == ctx )
+	clearPidFlag(pidFlags, pid, PID_FLAG_DESCRAMBLE);
+    }
+    [self setDescramble:NO context:ctx];
+    contexts[ctx].service = service;
+    // not the next one to go, though it has no words yet
+    contexts[ctx].dwTick = coarseClockUpdate();
+    memset(contexts[ctx].even_dw, 0, 8);
+    memset(contexts[ctx].odd_dw, 0, 8);
+  }
+  currentContext = ctx;
+  [dataLock unlock];
+  return ctx;
+}
+
+// a new transponder, none of the services is there any more
+- (void)clearKeyContexts
+{
+  [self clearDescramblerPidList];
+  [dataLock lock];
+  for(int i = 0; i < KEY_CONTEXTS; i++)
+  {
+    [self setDescramble:NO context:i];
+    contexts[i].service = 0;
+    memset(contexts[i].even_dw, 0, 8);
+    memset(contexts[i].odd_dw, 0, 8);
+  }
+  [dataLock unlock];
+}
+
+- (void)applyControlWords:(unsigned char *)dw service:(unsigned long)service
+{
+  static unsigned char zero_dw[8] = {0,0,0,0,0,0,0,0};
+  
+  for(int i = 0; i < 16; i += 4)
+  {
+    dw[i+3] = dw[i] + dw[i + 1] + dw[i + 2];
+  }
+  [dataLock lock];
+  int ctx = currentContext;
+  for(int i = 0; i < KEY_CONTEXTS && service != 0; i++)
+  {
+    if( contexts[i].service == service )
+      ctx = i;
+  }
+  keyContext *kc = &contexts[ctx];
+  if( memcmp(&dw[0], kc->even_dw, 8 ) != 0 && memcmp(&dw[0], zero_dw, 8) != 0 )
+  {
+    memcpy(kc->even_dw, &dw[0], 8);
+    set_even_control_word(kc->keys, &dw[0]);
+  }
+  if( memcmp(&dw[8], kc->odd_dw, 8 ) != 0 && memcmp(&dw[8], zero_dw, 8) != 0 )
+  {
+    memcpy(kc->odd_dw, &dw[8], 8);
+    set_odd_control_word(kc->keys, &dw[8]);
+  }
+  uint32_t tick = coarseClockUpdate();
+  kc->dwTick = tick;
+  kc->validUntil = tick + CW_TIMEOUT;
+  kc->dwSeq++;
+  __sync_synchronize();   // the deadline is set before the packet thread sees the flag
+  kc->descramble = YES;
+  [dataLock unlock];
+}
+
+/* Called by the packet thread for every batch of packets: a new control word
+ * from the daemon's key slot is in use from the next packet on, without
+ * waiting for the msg_dw notification (which still comes, and then finds
+ * nothing new). */
+- (void)pollControlWords
+{
+  if( cwsOpen == false || cwSlotSequence(&cws) == cwsSeq )
+    return;
+  unsigned char dw[16];
+  uint64_t stamp;
+  uint32_t service;
+  cwsSeq = cwSlotRead(&cws, dw, &stamp, &service);
+  // a slot that hasn't been written for a minute is left from an earlier session
+  if( coarseTickReached(coarseTick, (uint32_t)(stamp / 1000) + 60000) )
+    return;
+  [self applyControlWords:dw service:service];
 }
 
 - (void)decodeCwdwgwMessage:(NSData *)pmsg
@@ -122,34 +231,22 @@ extern NSCondition *pidFilter[MAX_DEVICES];
       } break;
       case msg_dw:
       {
-	static unsigned char zero_dw[8] = {0,0,0,0,0,0,0,0};
-	
 	newDw *dw = (newDw *)[pmsg bytes];
-	for(int i = 0; i < 16; i += 4)
-	{
-	  dw->dw[i+3] = dw->dw[i] + dw->dw[i + 1] + dw->dw[i + 2];
-	}
-	if( memcmp(&dw->dw[0], even_dw, 8 ) != 0 && memcmp(&dw->dw[0], zero_dw, 8) != 0 )
-	{
-	  memcpy(even_dw, &dw->dw[0], 8);
-	  set_even_control_word(keys, &dw->dw[0]);
-	}
-	if( memcmp(&dw->dw[8], odd_dw, 8 ) != 0 && memcmp(&dw->dw[8], zero_dw, 8) != 0 )
-	{
-	  memcpy(odd_dw, &dw->dw[8], 8);
-	  set_odd_control_word(keys, &dw->dw[8]);
-	  
-	}
-	doDescramble = YES;
-	lastDwTime = [[NSDate date] timeIntervalSince1970];
+	unsigned long service = [pmsg length] >= sizeof(newDw) ? ntohl(dw->mService) : 0;
+	[self applyControlWords:dw->dw service:service];
       } break;
 	
       case msg_ca_change:
-	doDescramble = NO;
+	// the daemon follows the current service
+	[dataLock lock];
+	[self setDescramble:NO context:currentContext];
+	[dataLock unlock];
+	[self resetSections];
 	break;
 	
       case msg_camd_online:
       {
+	[self resetSections];
 	extern VLCEyeTVPluginGlobals_t *lGlobals;
 	if( lGlobals != 0 )
 	{
@@ -170,9 +267,7 @@ extern NSCondition *pidFilter[MAX_DEVICES];
 	    
 	    msgNewChannel message;
 	    fillNewChannelMessage(&message, deviceInfo->transponderID, deviceInfo->serviceID, pmtpid);
-	    NSArray *ncMsg = [NSArray arrayWithObjects:[NSData dataWithBytes:&message length:sizeof(message)],
-			      [NSNumber numberWithInt:deviceIndex], nil]; 
-	    [self sendData:[NSArray arrayWithObjects:ncMsg,nil]];
+	    [self sendPacket:(const unsigned char *)&message length:sizeof(message)];
 	  }
 	}
       }	break;
@@ -218,63 +313,161 @@ extern NSCondition *pidFilter[MAX_DEVICES];
   [dmsg release];
 }
 
+/* The PID lists are one flags byte per PID. The packet thread reads the bytes
+ * without locking; writers serialize on dataLock and change a single flag
+ * with an atomic and/or, so the other flag of the byte is never lost. */
+
+static inline void setPidFlag(volatile unsigned char *flags, unsigned int pid, unsigned char flag)
+{
+  if( pid < PID_COUNT )
+    __sync_fetch_and_or(&flags[pid], flag);
+}
+
+static inline void clearPidFlag(volatile unsigned char *flags, unsigned int pid, unsigned char flag)
+{
+  if( pid < PID_COUNT )
+    __sync_fetch_and_and(&flags[pid], (unsigned char)~flag);
+}
+
+- (const volatile unsigned char *)pidFlags
+{
+  return pidFlags;
+}
+
+/* Forwards a TS packet or a message to the daemon through the device ring.
+ * Without a ring, or when the daemon doesn't keep up, it goes the old way. */
+- (void)sendPacket:(const unsigned char *)bytes length:(int)len
+{
+  if( ringOpen == true )
+  {
+    pthread_mutex_lock(&ringLock);
+    bool pushed = tsringPush(&ring, bytes, len);
+    pthread_mutex_unlock(&ringLock);
+    if( pushed == true )
+      return;
+  }
+  NSArray *sndData = [NSArray arrayWithObjects:[NSData dataWithBytes:bytes length:len], [NSNumber numberWithInt:deviceIndex], nil];
+  [self sendData:[NSArray arrayWithObjects:sndData, nil]];
+}
+
+/* Forwards the packets of a PID_FLAG_SEND PID in complete section units,
+ * leaving out the ones forwarded lately, see sectionGate.h. Packet thread
+ * only; other threads ask for a fresh start with -resetSections, or for one
+ * PID with -addPid:. */
+- (void)sendSectionPacket:(const unsigned char *)pkt info:(const tsPacketInfo *)info
+{
+  unsigned int pid = info->pid;
+  uint32_t generation = gatesGeneration;
+  if( generation != gatesSeen )
+  {
+    gatesSeen = generation;
+    for(unsigned int i = 0; i < PID_COUNT; i++)
+    {
+      sectionGateFree(gates[i]);
+      gates[i] = NULL;
+    }
+  }
+  if( gates[pid] == NULL )
+    gates[pid] = sectionGateNew();
+  if( gates[pid] == NULL )
+  {
+    [self sendPacket:pkt length:188];
+    return;
+  }
+  if( pidFlags[pid] & PID_FLAG_NEW_GATE )
+  {
+    clearPidFlag(pidFlags, pid, PID_FLAG_NEW_GATE);
+    sectionGateReset(gates[pid]);
+  }
+  const unsigned char *unit;
+  int count = sectionGatePacket(gates[pid], pkt, info, &unit);
+  for(int i = 0; i < count; i++)
+  {
+    [self sendPacket:unit + 188 * i length:188];
+  }
+}
+
+- (void)resetSections
+{
+  __sync_fetch_and_add(&gatesGeneration, 1);
+}
+
 - (void)clearPidList
 {
   [dataLock lock];
-  [pidList removeAllIndexes];
+  for(unsigned int pid = 0; pid < PID_COUNT; pid++)
+  {
+    if( pidFlags[pid] & PID_FLAG_SEND )
+      clearPidFlag(pidFlags, pid, PID_FLAG_SEND);
+  }
   [dataLock unlock];
 }
 
 - (bool)isPidInList:(unsigned int)pid
 {
-  [dataLock lock];
-  bool result =  [pidList containsIndex:pid];
-  [dataLock unlock];
-  return result;
+  return pid < PID_COUNT && (pidFlags[pid] & PID_FLAG_SEND) != 0;
 }
 
 - (bool)isPidInDescramblerList:(unsigned int)pid
 {
-  [dataLock lock];
-  bool result =  [decryptPids containsIndex:pid];
-  [dataLock unlock];
-  return result;
+  return pid < PID_COUNT && (pidFlags[pid] & PID_FLAG_DESCRAMBLE) != 0;
 }
 
+/* The daemon wants the sections of the PID, even the ones sent before; the
+ * packet thread starts its gate over, the other PIDs keep theirs. */
 - (void)addPid:(unsigned int)pid
 {
   [dataLock lock];
-  if( [pidList containsIndex:pid] != YES )
-  {
-    [pidList addIndex:pid];
-  }
+  setPidFlag(pidFlags, pid, PID_FLAG_NEW_GATE);
+  setPidFlag(pidFlags, pid, PID_FLAG_SEND);
   [dataLock unlock];
 }
 
-- (void)addPidToDescrambler:(unsigned int)pid
+- (void)addPidToDescrambler:(unsigned int)pid context:(int)ctx
 {
+  if( pid >= PID_COUNT || ctx < 0 || ctx >= KEY_CONTEXTS )
+    return;
   [dataLock lock];
-  [decryptPids addIndex:pid];
+  // the context first, the packet thread reads it once it sees the flag
+  pidContext[pid] = ctx;
+  __sync_synchronize();
+  setPidFlag(pidFlags, pid, PID_FLAG_DESCRAMBLE);
   [dataLock unlock];
 }
 
+- (const volatile unsigned char *)pidContexts
+{
+  return pidContext;
+}
+
 - (void)removePid:(unsigned int)pid;
 {
   [dataLock lock];
-  [pidList removeIndex:pid];
+  clearPidFlag(pidFlags, pid, PID_FLAG_SEND);
   [dataLock unlock];
 }
 
 - (void)clearDescramblerPidList
 {
   [dataLock lock];
-  [decryptPids removeAllIndexes];
+  for(unsigned int pid = 0; pid < PID_COUNT; pid++)
+  {
+    if( pidFlags[pid] & PID_FLAG_DESCRAMBLE )
+      clearPidFlag(pidFlags, pid, PID_FLAG_DESCRAMBLE);
+  }
   [dataLock unlock];
 }
 
 - (void)setDevIndex:(int)index
 {
   deviceIndex = index;
+  if( ringOpen == true )
+    tsringClose(&ring);
+  ringOpen = tsringOpen(&ring, deviceIndex);
+  if( cwsOpen == true )
+    cwSlotClose(&cws);
+  cwsOpen = cwSlotOpen(&cws, deviceIndex);
+  cwsSeq = 0;
 }
 
 - (int)getDevIndex
@@ -294,6 +487,7 @@ extern NSCondition *pidFilter[MAX_DEVICES];
 						      selector:@selector(rcvPidsAndControls:) 
 							  name:observerName object:nil];
   [NSTimer scheduledTimerWithTimeInterval:10 target:obj selector:@selector(pidFilterEvent:) userInfo:nil repeats:YES];  
+  [NSTimer scheduledTimerWithTimeInterval:COARSE_CLOCK_PERIOD target:obj selector:@selector(clockEvent:) userInfo:nil repeats:YES];
   do
   {
     [[NSRunLoop currentRunLoop] run];
@@ -302,147 +496,98 @@ extern NSCondition *pidFilter[MAX_DEVICES];
   [pool release];
 }
 
-/* Structure for TS-Packets */
-typedef struct 
-{
-  unsigned char header[4];
-  unsigned char	data[188-4];
-} TransportStreamPacket;
-
-- (void)pidFilterEvent:(NSTimer *)timerObj
+- (void)clockEvent:(NSTimer *)timerObj
 {
+  coarseClockUpdate();
 }
 
-- (int)blockDecrypt:(int)blockSize
+- (void)pidFilterEvent:(NSTimer *)timerObj
 {
-  NSArray *packets = [tsPackets objectsAtIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0,blockSize)]];
-  int elements = ([packets count] * 2) + 1;
-  unsigned char *dp[elements];
-  for(int i = 0, j = 0;  i < [packets count]; i++, j += 2 )
-  {
-    dp[j] = (unsigned char *)[[packets objectAtIndex:i] bytes];
-    dp[j + 1] = dp[j] + 188;
-  }
-  dp[elements - 1] = 0;
 #ifdef SHOW_SPEED_STATISTICS
-	CFAbsoluteTime		startTime = CFAbsoluteTimeGetCurrent();
+  deviceStatistics st;
+  [self statistics:&st];
+  NSMutableString *fill = [NSMutableString string];
+  for(int i = 0; i < STATS_FILL_BINS; i++)
+    [fill appendFormat:@" %llu", st.fill[i]];
+  [self logMessage:[NSString stringWithFormat:@"device %d: packets:%llu, scrambled:%llu, decrypted:%llu, by the worker:%llu, calls:%llu, fill:%@, parallelism:%d, net speed:%.3f Mbps, cw age:%.1f s, parity age:%.1f s\n",
+		    deviceIndex, st.packets, st.scrambled, st.decrypted, st.offloaded, st.calls, fill, st.parallelism, st.decryptMbps, st.cwAge, st.parityAge]];
 #endif
+}
 
-  int descrambled = decrypt_packets(keys, dp);
-#ifdef SHOW_SPEED_STATISTICS
-	CFAbsoluteTime		endTime = CFAbsoluteTimeGetCurrent();
-	speedStatisticsDuration += endTime - startTime;
-	speedStatisticsPackets += descrambled;
-	speedStatisticsClusters++;
-	if ((speedStatisticsDuration > 0.) && ((endTime - speedStatisticsLastOutput) >= 1.0))
-	{
-		double		netBits = (double)speedStatisticsPackets * 188. * 8.;
-		double		netSpeed = netBits / speedStatisticsDuration;
-		double		efficiency = (double)speedStatisticsPackets * 100. / ((double)speedStatisticsClusters * (double)packetsBlockCount);
-		
-		[self logMessage:[NSString stringWithFormat:@"packetsBlockCount:%d, packets:%ld, clusters:%ld, duration:%.6f, efficiency:%6.2f%%, net speed:%.3f Mbps\n", packetsBlockCount, speedStatisticsPackets, speedStatisticsClusters, speedStatisticsDuration, efficiency, netSpeed / 1000000.]];
-		
-		speedStatisticsLastOutput = endTime;
-		speedStatisticsDuration = 0.;
-		speedStatisticsPackets = 0;
-		speedStatisticsClusters = 0;
-	}
-#endif
-  for(int i = 0; i < descrambled; i++)
-  {
-    [cleanPackets addObject:[packets objectAtIndex:i]];
-  }
-  [tsPackets removeObjectsInRange:NSMakeRange(0, descrambled)];
-  return descrambled;
+- (void)countPackets:(int)count
+{
+  countersWriteBegin(&statSeq);
+  statPackets += count;
+  countersWriteEnd(&statSeq);
 }
 
-- (void)descramblerEvent:(NSTimer *)timerObj
+/* Decrypts the packets in place, where EyeTV handed them over, in one pass.
+ * Clear packets among them are left alone. With a worker it takes half of
+ * them, see descrambler.h. */
+- (void)descramblePackets:(unsigned char **)pkts keys:(const int *)keyIndex count:(int)count
 {
-//  NSAutoreleasePool*  pool = [[NSAutoreleasePool alloc] init];
-//  [descrambler wait];
-  [descramblerLock lock];
-  if( [tsPackets count] >= packetsBlockCount )
+  if( count == 0 )
+    return;
+  /* The daemon follows one service per device, the others keep the words
+   * they had. A control word covers a crypto period, so the second parity
+   * change of a service without a new one means its words are stale. Its
+   * PIDs change within PARITY_SETTLE of each other, that is one change. */
+  uint32_t tick = coarseTick;
+  for(int i = 0; i < count; i++)
   {
-    int more = packetsBlockCount - [self blockDecrypt:packetsBlockCount];
-    while( more != 0 )
+    int ctx = keyIndex[i];
+    int parity = pkts[i][3] & 0xc0;
+    if( parity == contextParity[ctx] )
+      continue;
+    if( contextParity[ctx] != 0 && (uint32_t)(tick - flipTick[ctx]) >= PARITY_SETTLE )
     {
-      more = more - [self blockDecrypt:more];
+      uint32_t seq = contexts[ctx].dwSeq;
+      if( seq == flipSeq[ctx] )
+	staleMask |= 1 << ctx;
+      flipSeq[ctx] = seq;
+      flipTick[ctx] = tick;
+      parityTick = tick;
+      parityChanged = true;
     }
+    contextParity[ctx] = parity;
   }
-  [descramblerLock unlock];
-//  [pool release];
-}
-
-- (void)appendTsPacket:(unsigned char *)pbytes length:(int)len
-{
-  bool doSignal = NO;
-  NSData *pd = [[NSData alloc] initWithBytes:pbytes length:len];
-  [descramblerLock lock];
-  [tsPackets addObject:pd];
-  if( [tsPackets count] >= packetsBlockCount )
-    doSignal = YES;
-  [descramblerLock unlock];
-  if( doSignal == YES )
-    [self descramblerEvent:nil];
-  [pd release];
-}
-
-static inline int payload(const unsigned char *tsp)
-{
-  TSHeader hdr;
-  hdr.word = ntohl(*(unsigned int *)tsp);
-  int pOffset = 0, pLen = 184;
-  
-  if( hdr.ts.transportErr != 0 ) return -1;
-  switch( hdr.ts.adaption )
-  {                                                                                                                                        
-    case 1:
-      break;    // payload only
-    case 2:
-      return 0; // no payload
-    case 3:
-      pOffset = 1 + tsp[4];
-      pLen -= pOffset;
-      break;
-    default:
-      return -1;
-  }
-  if( hdr.ts.payloadStart != 0 )
+  countersWriteBegin(&statSeq);
+  statScrambled += count;
+  countersWriteEnd(&statSeq);
+  if( worker != NULL )
   {
-    int additional = tsp[4 + pOffset] + 1;
-    pOffset += additional;
-    pLen -= additional;
+    descramblerDecrypt(worker, pkts, keyIndex, count, &counters);
+    return;
   }
-  if( pOffset < 0 || pLen < 0 ) return -1;
-  if( (pOffset + pLen) != 184) return -1;
-  return pLen;
+  uint64_t start = cwSlotNow();
+  decrypt_packets_iov_multi(contextKeys, KEY_CONTEXTS, pkts, keyIndex, count);
+  decryptCountersAdd(&counters, count, packetsBlockCount, cwSlotNow() - start);
 }
 
-- (void)getCleanTsPacket:(unsigned char *)buffer
+/* A snapshot of the statistics, for any thread. Each group of counters is
+ * consistent in itself, the groups may be a callback apart. */
+- (void)statistics:(deviceStatistics *)stats
 {
-  [descramblerLock lock];
-  NSData *obj = nil;
-  if( [cleanPackets count] > 0 )
-  {
-    obj = [[cleanPackets objectAtIndex:0] retain];
-    [cleanPackets removeObjectAtIndex:0];
-  }
-  [descramblerLock unlock];
-  if( obj != nil )
+  memset(stats, 0, sizeof(*stats));
+  uint32_t seq;
+  do
   {
-    [obj getBytes:buffer length:188];
-    [obj release];
+    seq = countersReadBegin(&statSeq);
+    stats->packets = statPackets;
+    stats->scrambled = statScrambled;
   }
+  while( countersReadRetry(&statSeq, seq) );
+  decryptCountersRead(&counters, stats);
+  if( worker != NULL )
+    descramblerStatistics(worker, stats);
+  stats->parallelism = packetsBlockCount;
+  stats->cwAge = (double)(uint32_t)(coarseClockUpdate() - contexts[currentContext].dwTick) / 1000.;
+  stats->parityAge = parityChanged == true ? (double)(uint32_t)(coarseClockUpdate() - parityTick) / 1000. : -1.;
 }
 
 - (void)channelChange
 {
-  [dataLock lock];
-  [cleanPackets removeAllObjects];
-  [dataLock unlock];
-  [descramblerLock lock];
-  [tsPackets removeAllObjects];
-  [descramblerLock unlock];
+  [self resetSections];
 }
 
 - (void)rcvPidsAndControls:(NSNotification *)obj
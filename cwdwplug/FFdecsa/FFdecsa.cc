@@ -22,860 +22,758 @@
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
 
 #include "FFdecsa.h"
+#include "FFdecsa_engine.h"
 
 #ifndef NULL
 #define NULL 0
 #endif
 
-//#define DEBUG
-#ifdef DEBUG
-#define DBG(a) a
-#else
-#define DBG(a)
+//// every engine is built into the binary, the one to use is chosen at
+//// run time from what the cpu supports.
+//// Define PARALLEL_MODE when building this file to pin a single engine.
+
+// all engines, for lookup by mode
+static const struct ffdecsa_engine *const all_engines[]={
+  &ffdecsa_engine_032_4char,
+  &ffdecsa_engine_032_4charA,
+  &ffdecsa_engine_032_int,
+  &ffdecsa_engine_064_8char,
+  &ffdecsa_engine_064_8charA,
+  &ffdecsa_engine_064_2int,
+  &ffdecsa_engine_064_long,
+  &ffdecsa_engine_128_16char,
+  &ffdecsa_engine_128_16charA,
+  &ffdecsa_engine_128_4int,
+  &ffdecsa_engine_128_2long,
+#ifdef FFDECSA_X86
+  &ffdecsa_engine_064_mmx,
+  &ffdecsa_engine_128_2mmx,
+  &ffdecsa_engine_128_sse,
+  &ffdecsa_engine_128_sse2,
 #endif
-
-//// parallelization stuff, large speed differences are possible
-// possible choices
-#define PARALLEL_32_4CHAR     320
-#define PARALLEL_32_4CHARA    321
-#define PARALLEL_32_INT       322
-#define PARALLEL_64_8CHAR     640
-#define PARALLEL_64_8CHARA    641
-#define PARALLEL_64_2INT      642
-#define PARALLEL_64_LONG      643
-#define PARALLEL_64_MMX       644
-#define PARALLEL_128_16CHAR  1280
-#define PARALLEL_128_16CHARA 1281
-#define PARALLEL_128_4INT    1282
-#define PARALLEL_128_2LONG   1283
-#define PARALLEL_128_2MMX    1284
-#define PARALLEL_128_SSE     1285
-#define PARALLEL_128_SSE2    1286
+  NULL
+};
 
 //////// our choice //////////////// our choice //////////////// our choice //////////////// our choice ////////
-#ifndef PARALLEL_MODE
-#define PARALLEL_MODE PARALLEL_32_INT				// up to 170 Mbps
-// #define PARALLEL_MODE PARALLEL_64_MMX				// up to 350 Mbps -> crash on some stream
-// #define PARALLEL_MODE PARALLEL_128_SSE			// up to 500 Mbps -> always crash
-// #define PARALLEL_MODE PARALLEL_128_SSE2			// up to 550 Mbps -> always crash
+// best first, the first one the cpu can run and that passes verify_engine() wins.
+static const struct ffdecsa_engine *const preferred_engines[]={
+#ifdef FFDECSA_X86
+  &ffdecsa_engine_128_sse2,   // up to 550 Mbps
+#endif
+#ifdef __LP64__
+  &ffdecsa_engine_128_2long,  // plain 64 bit registers, well vectorized by the compiler
+#endif
+#ifdef FFDECSA_X86
+  &ffdecsa_engine_128_sse,    // up to 500 Mbps
+  &ffdecsa_engine_064_mmx,    // up to 350 Mbps
 #endif
+  &ffdecsa_engine_032_int,    // up to 170 Mbps, runs everywhere, reference for the others
+  NULL
+};
 //////// our choice //////////////// our choice //////////////// our choice //////////////// our choice ////////
 
-#include "parallel_generic.h"
-//// conditionals
-#if PARALLEL_MODE==PARALLEL_32_4CHAR
-#include "parallel_032_4char.h"
-#elif PARALLEL_MODE==PARALLEL_32_4CHARA
-#include "parallel_032_4charA.h"
-#elif PARALLEL_MODE==PARALLEL_32_INT
-#include "parallel_032_int.h"
-#elif PARALLEL_MODE==PARALLEL_64_8CHAR
-#include "parallel_064_8char.h"
-#elif PARALLEL_MODE==PARALLEL_64_8CHARA
-#include "parallel_064_8charA.h"
-#elif PARALLEL_MODE==PARALLEL_64_2INT
-#include "parallel_064_2int.h"
-#elif PARALLEL_MODE==PARALLEL_64_LONG
-#include "parallel_064_long.h"
-#elif PARALLEL_MODE==PARALLEL_64_MMX
-#include "parallel_064_mmx.h"
-#elif PARALLEL_MODE==PARALLEL_128_16CHAR
-#include "parallel_128_16char.h"
-#elif PARALLEL_MODE==PARALLEL_128_16CHARA
-#include "parallel_128_16charA.h"
-#elif PARALLEL_MODE==PARALLEL_128_4INT
-#include "parallel_128_4int.h"
-#elif PARALLEL_MODE==PARALLEL_128_2LONG
-#include "parallel_128_2long.h"
-#elif PARALLEL_MODE==PARALLEL_128_2MMX
-#include "parallel_128_2mmx.h"
-#elif PARALLEL_MODE==PARALLEL_128_SSE
-#include "parallel_128_sse.h"
-#elif PARALLEL_MODE==PARALLEL_128_SSE2
-#include "parallel_128_sse2.h"
+//-----cpu features
+
+#ifdef FFDECSA_X86
+static void cpuid(unsigned int op, unsigned int *a, unsigned int *b, unsigned int *c, unsigned int *d){
+#if defined(__i386__) && defined(__PIC__)
+  // ebx holds the GOT pointer, don't let the compiler see it clobbered
+  __asm__ __volatile__("movl %%ebx,%%esi\n\t"
+                       "cpuid\n\t"
+                       "xchgl %%ebx,%%esi"
+                       : "=a"(*a), "=S"(*b), "=c"(*c), "=d"(*d)
+                       : "a"(op), "c"(0));
 #else
-#error "unknown/undefined parallel mode"
+  __asm__ __volatile__("cpuid"
+                       : "=a"(*a), "=b"(*b), "=c"(*c), "=d"(*d)
+                       : "a"(op), "c"(0));
+#endif
+}
+#endif
+
+static unsigned int cpu_features(void){
+  unsigned int features=0;
+#ifdef FFDECSA_X86
+  unsigned int a,b,c,d;
+  cpuid(0,&a,&b,&c,&d);
+  if(a>=1){
+    cpuid(1,&a,&b,&c,&d);
+    if(d&(1<<23)) features|=FFDECSA_CPU_MMX;
+    if(d&(1<<25)) features|=FFDECSA_CPU_SSE;
+    if(d&(1<<26)) features|=FFDECSA_CPU_SSE2;
+  }
 #endif
+  return features;
+}
 
-// stuff depending on conditionals
+//-----engine verification
+
+// differential check of an engine against PARALLEL_32_INT: a pseudo random
+// cluster with every adaptation field length (so every n and residue) in
+// both parities, interleaved with clear and reserved packets, must decrypt
+// to the same bytes. The per packet key path (decrypt_packets_multi) is
+// checked the same way, 32_INT's own included. Both the engine and 32_INT
+// have to get the known answer below first.
+
+// known answer: two packets, the first even with a full payload, the second
+// odd with an 11 byte adaptation field (a 4 byte residue), decrypted by the
+// FFdecsa this tree started from
+
+static const unsigned char kat_even[8]={0x12,0x34,0x56,0x9c,0x78,0x9a,0xbc,0xce};
+static const unsigned char kat_odd[8]={0x11,0x22,0x33,0x66,0x44,0x55,0x66,0xff};
+
+static const unsigned char kat_scrambled[2*188]={
+  0x47,0x00,0x64,0x90,0x9f,0xc4,0xe9,0x0e,0x33,0x58,0x7d,0xa2,
+  0xc7,0xec,0x11,0x36,0x5b,0x80,0xa5,0xca,0xef,0x14,0x39,0x5e,
+  0x83,0xa8,0xcd,0xf2,0x17,0x3c,0x61,0x86,0xab,0xd0,0xf5,0x1a,
+  0x3f,0x64,0x89,0xae,0xd3,0xf8,0x1d,0x42,0x67,0x8c,0xb1,0xd6,
+  0xfb,0x20,0x45,0x6a,0x8f,0xb4,0xd9,0xfe,0x23,0x48,0x6d,0x92,
+  0xb7,0xdc,0x01,0x26,0x4b,0x70,0x95,0xba,0xdf,0x04,0x29,0x4e,
+  0x73,0x98,0xbd,0xe2,0x07,0x2c,0x51,0x76,0x9b,0xc0,0xe5,0x0a,
+  0x2f,0x54,0x79,0x9e,0xc3,0xe8,0x0d,0x32,0x57,0x7c,0xa1,0xc6,
+  0xeb,0x10,0x35,0x5a,0x7f,0xa4,0xc9,0xee,0x13,0x38,0x5d,0x82,
+  0xa7,0xcc,0xf1,0x16,0x3b,0x60,0x85,0xaa,0xcf,0xf4,0x19,0x3e,
+  0x63,0x88,0xad,0xd2,0xf7,0x1c,0x41,0x66,0x8b,0xb0,0xd5,0xfa,
+  0x1f,0x44,0x69,0x8e,0xb3,0xd8,0xfd,0x22,0x47,0x6c,0x91,0xb6,
+  0xdb,0x00,0x25,0x4a,0x6f,0x94,0xb9,0xde,0x03,0x28,0x4d,0x72,
+  0x97,0xbc,0xe1,0x06,0x2b,0x50,0x75,0x9a,0xbf,0xe4,0x09,0x2e,
+  0x53,0x78,0x9d,0xc2,0xe7,0x0c,0x31,0x56,0x7b,0xa0,0xc5,0xea,
+  0x0f,0x34,0x59,0x7e,0xa3,0xc8,0xed,0x12,0x47,0x00,0x64,0xf1,
+  0x0b,0xf0,0x15,0x3a,0x5f,0x84,0xa9,0xce,0xf3,0x18,0x3d,0x62,
+  0x87,0xac,0xd1,0xf6,0x1b,0x40,0x65,0x8a,0xaf,0xd4,0xf9,0x1e,
+  0x43,0x68,0x8d,0xb2,0xd7,0xfc,0x21,0x46,0x6b,0x90,0xb5,0xda,
+  0xff,0x24,0x49,0x6e,0x93,0xb8,0xdd,0x02,0x27,0x4c,0x71,0x96,
+  0xbb,0xe0,0x05,0x2a,0x4f,0x74,0x99,0xbe,0xe3,0x08,0x2d,0x52,
+  0x77,0x9c,0xc1,0xe6,0x0b,0x30,0x55,0x7a,0x9f,0xc4,0xe9,0x0e,
+  0x33,0x58,0x7d,0xa2,0xc7,0xec,0x11,0x36,0x5b,0x80,0xa5,0xca,
+  0xef,0x14,0x39,0x5e,0x83,0xa8,0xcd,0xf2,0x17,0x3c,0x61,0x86,
+  0xab,0xd0,0xf5,0x1a,0x3f,0x64,0x89,0xae,0xd3,0xf8,0x1d,0x42,
+  0x67,0x8c,0xb1,0xd6,0xfb,0x20,0x45,0x6a,0x8f,0xb4,0xd9,0xfe,
+  0x23,0x48,0x6d,0x92,0xb7,0xdc,0x01,0x26,0x4b,0x70,0x95,0xba,
+  0xdf,0x04,0x29,0x4e,0x73,0x98,0xbd,0xe2,0x07,0x2c,0x51,0x76,
+  0x9b,0xc0,0xe5,0x0a,0x2f,0x54,0x79,0x9e,0xc3,0xe8,0x0d,0x32,
+  0x57,0x7c,0xa1,0xc6,0xeb,0x10,0x35,0x5a,0x7f,0xa4,0xc9,0xee,
+  0x13,0x38,0x5d,0x82,0xa7,0xcc,0xf1,0x16,0x3b,0x60,0x85,0xaa,
+  0xcf,0xf4,0x19,0x3e
+};
 
-#define BYTES_PER_GROUP (GROUP_PARALLELISM/8)
-#define BYPG BYTES_PER_GROUP
-#define BITS_PER_GROUP GROUP_PARALLELISM
-#define BIPG BITS_PER_GROUP
+static const unsigned char kat_clear[2*188]={
+  0x47,0x00,0x64,0x10,0x22,0xe0,0x32,0xc2,0x7b,0x0e,0x95,0x16,
+  0x71,0x76,0xee,0x02,0xdb,0x14,0x37,0x6f,0x05,0xd1,0x48,0x87,
+  0x62,0x1d,0xe6,0x98,0xee,0x15,0xfa,0x30,0xb0,0x4d,0x78,0x8b,
+  0x68,0x5d,0xb6,0x9d,0xb1,0xf0,0x0d,0xf8,0xe3,0x76,0xd9,0x8b,
+  0x53,0xdc,0xf5,0xfb,0xca,0x57,0xb4,0x82,0xbb,0x69,0xd1,0x4f,
+  0x2c,0x77,0x8a,0x48,0x07,0x45,0x3e,0x76,0x5b,0xfb,0x02,0x6f,
+  0x2e,0xfd,0xf4,0x75,0x4f,0x3f,0xa9,0xf1,0xac,0x73,0x3c,0x58,
+  0xbc,0x87,0xa6,0xd0,0x6a,0xfd,0x8f,0x3a,0xe6,0x29,0x85,0xfd,
+  0x47,0x06,0xb6,0xe8,0xd8,0x3b,0xd3,0xc2,0xc5,0x46,0xb4,0x6a,
+  0xd9,0x00,0x3c,0x04,0xd4,0xa3,0x08,0xc9,0x8d,0xf1,0x49,0x71,
+  0xb1,0x29,0xdf,0xc9,0x40,0xa7,0x63,0xb8,0x08,0xbb,0xd8,0xe3,
+  0x3b,0x58,0x28,0x23,0x79,0xb5,0x43,0xe1,0x1d,0x10,0x90,0x0e,
+  0x81,0xae,0xf0,0xc2,0x62,0xcf,0x9d,0x86,0xbb,0x2b,0x36,0x85,
+  0x81,0xdb,0xb1,0x11,0x00,0x8a,0x9d,0xb1,0x7a,0xd8,0xb3,0xfb,
+  0xbc,0x25,0x4b,0xbf,0x4c,0x56,0x16,0x9e,0x47,0xbc,0x4a,0x67,
+  0xc2,0xac,0xf0,0x07,0xee,0xff,0x8c,0x41,0x47,0x00,0x64,0x31,
+  0x0b,0xf0,0x15,0x3a,0x5f,0x84,0xa9,0xce,0xf3,0x18,0x3d,0x62,
+  0xd7,0xaf,0xd8,0x8b,0x85,0x9b,0xdd,0x5a,0x01,0xbb,0xa1,0x09,
+  0xdc,0x35,0x0c,0xbe,0x70,0x11,0x7d,0x0e,0x11,0xe4,0xf0,0x0f,
+  0xef,0xfc,0xb3,0x46,0xcd,0xac,0x22,0x2b,0x65,0xc0,0xb0,0xc6,
+  0x85,0x44,0x84,0xc5,0x93,0x9d,0x29,0xa5,0x4d,0xdc,0xa1,0xb3,
+  0xd9,0x33,0x0f,0xac,0x15,0xa6,0x82,0x74,0x38,0x1e,0xaa,0xd9,
+  0xf1,0x42,0x8e,0xce,0x82,0x9a,0x7a,0x71,0x57,0xcc,0x5b,0xbb,
+  0x36,0xcb,0x7f,0xe5,0x39,0x7b,0x48,0x89,0x9c,0x08,0xd5,0x1f,
+  0xcb,0x59,0xb5,0x42,0xc4,0x66,0xeb,0xa4,0x7c,0x00,0x4b,0x98,
+  0xad,0x70,0xbc,0x9f,0x23,0x9e,0x17,0x65,0xe0,0xaa,0x25,0x66,
+  0x86,0xa0,0x30,0xea,0x42,0x4e,0x5f,0x7a,0x54,0x6f,0xd3,0x94,
+  0xb7,0x77,0xfc,0x7c,0xb2,0x6e,0x4d,0xc0,0x8b,0x50,0xa6,0x7d,
+  0x23,0x50,0x48,0x05,0x18,0xda,0x56,0x7b,0xb1,0x94,0x99,0x9d,
+  0xed,0x68,0x07,0x9b,0x1e,0xe8,0xca,0xe7,0x16,0x90,0xf3,0x08,
+  0x96,0x79,0x2c,0x72,0x25,0xb6,0x8f,0x01,0x07,0xd4,0x3b,0x3b,
+  0x72,0xc3,0xcb,0xc8
+};
 
-#ifndef MALLOC
-#define MALLOC(X) malloc(X)
-#endif
-#ifndef FREE
-#define FREE(X) free(X)
-#endif
-#ifndef MEMALIGN
-#define MEMALIGN
-#endif
+static int verify_known_answer(const struct ffdecsa_engine *e){
+  unsigned char buf[2*188];
+  unsigned char *cluster[3];
+  void *keys=e->get_key_struct();
+  if(keys==NULL) return 0;
+  memcpy(buf,kat_scrambled,sizeof(buf));
+  e->set_even_control_word(keys,kat_even);
+  e->set_odd_control_word(keys,kat_odd);
+  cluster[0]=buf;
+  cluster[1]=buf+sizeof(buf);
+  cluster[2]=NULL;
+  while(cluster[0]!=NULL){
+    e->decrypt_packets(keys,cluster);
+  }
+  e->free_key_struct(keys);
+  return memcmp(buf,kat_clear,sizeof(buf))==0;
+}
 
-//// debug tool
+#define VERIFY_PACKETS (2*184+64)
 
-static void dump_mem(const char *string, const unsigned char *p, int len, int linelen){
+static unsigned int verify_rand(unsigned int *seed){
+  *seed=*seed*1103515245+12345;
+  return (*seed>>16)&0x7fff;
+}
+
+static void verify_decrypt(const struct ffdecsa_engine *e, unsigned char *buf, const unsigned char *ev, const unsigned char *od){
+  unsigned char *cluster[3];
+  void *keys=e->get_key_struct();
+  if(keys==NULL) return;
+  e->set_even_control_word(keys,ev);
+  e->set_odd_control_word(keys,od);
+  cluster[0]=buf;
+  cluster[1]=buf+VERIFY_PACKETS*188;
+  cluster[2]=NULL;
+  while(cluster[0]!=NULL){
+    e->decrypt_packets(keys,cluster);
+  }
+  e->free_key_struct(keys);
+}
+
+// every packet its own range, alternating between a (ev,od) and an (od,ev) key
+static int verify_decrypt_multi(const struct ffdecsa_engine *e, unsigned char *buf, const unsigned char *ev, const unsigned char *od){
+  unsigned char *cluster[2*VERIFY_PACKETS+1];
+  int cluster_keys[VERIFY_PACKETS];
+  void *keys[2];
   int i;
-  for(i=0;i<len;i++){
-    if(i%linelen==0&&i) fprintf(stderr,"\n");
-    if(i%linelen==0) fprintf(stderr,"%s %08x:",string,i);
-    else{
-      if(i%8==0) fprintf(stderr," ");
-      if(i%4==0) fprintf(stderr," ");
+  keys[0]=e->get_key_struct();
+  keys[1]=e->get_key_struct();
+  if(keys[0]!=NULL&&keys[1]!=NULL){
+    e->set_even_control_word(keys[0],ev);
+    e->set_odd_control_word(keys[0],od);
+    e->set_even_control_word(keys[1],od);
+    e->set_odd_control_word(keys[1],ev);
+    for(i=0;i<VERIFY_PACKETS;i++){
+      cluster[2*i]=buf+188*i;
+      cluster[2*i+1]=buf+188*(i+1);
+      cluster_keys[i]=i&1;
+    }
+    cluster[2*VERIFY_PACKETS]=NULL;
+    while(cluster[0]!=NULL){
+      e->decrypt_packets_multi(keys,cluster,cluster_keys);
     }
-    fprintf(stderr," %02x",p[i]);
-  }
-  if(i%linelen==0) fprintf(stderr,"\n");
-}
-
-//////////////////////////////////////////////////////////////////////////////////
-
-struct csa_key_t{
-	unsigned char ck[8];
-// used by stream
-        int iA[8];  // iA[0] is for A1, iA[7] is for A8
-        int iB[8];  // iB[0] is for B1, iB[7] is for B8
-// used by stream (group)
-        MEMALIGN group ck_g[8][8]; // [byte][bit:0=LSB,7=MSB]
-        MEMALIGN group iA_g[8][4]; // [0 for A1][0 for LSB]
-        MEMALIGN group iB_g[8][4]; // [0 for B1][0 for LSB]
-// used by block
-	unsigned char kk[56];
-// used by block (group)
-	MEMALIGN batch kkmulti[56]; // many times the same byte in every batch
-};
-
-struct csa_keys_t{
-  struct csa_key_t even;
-  struct csa_key_t odd;
-};
+  }
+  if(keys[0]!=NULL) e->free_key_struct(keys[0]);
+  if(keys[1]!=NULL) e->free_key_struct(keys[1]);
+  return keys[0]!=NULL&&keys[1]!=NULL;
+}
 
-//-----stream cypher
-
-//-----key schedule for stream decypher
-static void key_schedule_stream(
-  unsigned char *ck,    // [In]  ck[0]-ck[7]   8 bytes   | Key.
-  int *iA,              // [Out] iA[0]-iA[7]   8 nibbles | Key schedule.
-  int *iB)              // [Out] iB[0]-iB[7]   8 nibbles | Key schedule.
-{
-    iA[0]=(ck[0]>>4)&0xf;
-    iA[1]=(ck[0]   )&0xf;
-    iA[2]=(ck[1]>>4)&0xf;
-    iA[3]=(ck[1]   )&0xf;
-    iA[4]=(ck[2]>>4)&0xf;
-    iA[5]=(ck[2]   )&0xf;
-    iA[6]=(ck[3]>>4)&0xf;
-    iA[7]=(ck[3]   )&0xf;
-    iB[0]=(ck[4]>>4)&0xf;
-    iB[1]=(ck[4]   )&0xf;
-    iB[2]=(ck[5]>>4)&0xf;
-    iB[3]=(ck[5]   )&0xf;
-    iB[4]=(ck[6]>>4)&0xf;
-    iB[5]=(ck[6]   )&0xf;
-    iB[6]=(ck[7]>>4)&0xf;
-    iB[7]=(ck[7]   )&0xf;
-}
-
-//----- stream main function
-
-#define STREAM_INIT
-#include "stream.c"
-#undef STREAM_INIT
-
-#define STREAM_NORMAL
-#include "stream.c"
-#undef STREAM_NORMAL
-
-
-//-----block decypher
-
-//-----key schedule for block decypher
-
-static void key_schedule_block(
-  unsigned char *ck,    // [In]  ck[0]-ck[7]   8 bytes | Key.
-  unsigned char *kk)    // [Out] kk[0]-kk[55] 56 bytes | Key schedule.
-{
-  static const unsigned char key_perm[0x40] = {
-    0x12,0x24,0x09,0x07,0x2A,0x31,0x1D,0x15, 0x1C,0x36,0x3E,0x32,0x13,0x21,0x3B,0x40,
-    0x18,0x14,0x25,0x27,0x02,0x35,0x1B,0x01, 0x22,0x04,0x0D,0x0E,0x39,0x28,0x1A,0x29,
-    0x33,0x23,0x34,0x0C,0x16,0x30,0x1E,0x3A, 0x2D,0x1F,0x08,0x19,0x17,0x2F,0x3D,0x11,
-    0x3C,0x05,0x38,0x2B,0x0B,0x06,0x0A,0x2C, 0x20,0x3F,0x2E,0x0F,0x03,0x26,0x10,0x37,
-  };
-
-  int i,j,k;
-  int bit[64];
-  int newbit[64];
-  int kb[7][8];
-
-  // 56 steps
-  // 56 key bytes kk(55)..kk(0) by key schedule from ck
-
-  // kb(6,0) .. kb(6,7) = ck(0) .. ck(7)
-  kb[6][0] = ck[0];
-  kb[6][1] = ck[1];
-  kb[6][2] = ck[2];
-  kb[6][3] = ck[3];
-  kb[6][4] = ck[4];
-  kb[6][5] = ck[5];
-  kb[6][6] = ck[6];
-  kb[6][7] = ck[7];
-
-  // calculate kb[5] .. kb[0]
-  for(i=5; i>=0; i--){
-    // 64 bit perm on kb
-    for(j=0; j<8; j++){
-      for(k=0; k<8; k++){
-        bit[j*8+k] = (kb[i+1][j] >> (7-k)) & 1;
-        newbit[key_perm[j*8+k]-1] = bit[j*8+k];
-      }
+static int verify_engine(const struct ffdecsa_engine *e){
+  const struct ffdecsa_engine *ref=&ffdecsa_engine_032_int;
+  unsigned char ev[8],od[8];
+  unsigned char *in,*a,*b,*c;
+  unsigned int seed=0x47e0e0;
+  int i,j,ok;
+
+  if(!verify_known_answer(ref)||!verify_known_answer(e)) return 0;
+  in=(unsigned char *)malloc(VERIFY_PACKETS*188);
+  a=(unsigned char *)malloc(VERIFY_PACKETS*188);
+  b=(unsigned char *)malloc(VERIFY_PACKETS*188);
+  c=(unsigned char *)malloc(VERIFY_PACKETS*188);
+  if(in==NULL||a==NULL||b==NULL||c==NULL){
+    free(in);
+    free(a);
+    free(b);
+    free(c);
+    return 0;
+  }
+  for(i=0;i<8;i++){
+    ev[i]=verify_rand(&seed);
+    od[i]=verify_rand(&seed);
+  }
+  for(i=0;i<VERIFY_PACKETS*188;i++){
+    in[i]=verify_rand(&seed);
+  }
+  for(i=0;i<VERIFY_PACKETS;i++){
+    unsigned char *pkt=in+188*i;
+    pkt[0]=0x47;
+    pkt[1]&=0x1f;
+    if(i<2*184){
+      // adaptation field length i/2, even and odd
+      pkt[3]=((i&1)?0xc0:0x80)|0x30|(pkt[3]&0x0f);
+      pkt[4]=i/2;
     }
-    for(j=0; j<8; j++){
-      kb[i][j] = 0;
-      for(k=0; k<8; k++){
-        kb[i][j] |= newbit[j*8+k] << (7-k);
-      }
+    else{
+      // full payload, some clear and reserved among them
+      static const unsigned char sc[4]={0x80,0xc0,0x00,0x40};
+      pkt[3]=sc[verify_rand(&seed)&3]|0x10|(pkt[3]&0x0f);
     }
   }
+  // shuffle, so parities and lengths come mixed
+  for(i=VERIFY_PACKETS-1;i>0;i--){
+    unsigned char t[188];
+    j=verify_rand(&seed)%(i+1);
+    memcpy(t,in+188*i,188);
+    memcpy(in+188*i,in+188*j,188);
+    memcpy(in+188*j,t,188);
+  }
 
-  // xor to give kk
-  for(i=0; i<7; i++){
-    for(j=0; j<8; j++){
-      kk[i*8+j] = kb[i][j] ^ i;
-    }
+  // one key for the whole cluster
+  memcpy(a,in,VERIFY_PACKETS*188);
+  memcpy(b,in,VERIFY_PACKETS*188);
+  verify_decrypt(ref,a,ev,od);
+  verify_decrypt(e,b,ev,od);
+  ok=memcmp(a,b,VERIFY_PACKETS*188)==0;
+
+  // a key per packet, every other one with the control words swapped
+  memcpy(b,in,VERIFY_PACKETS*188);
+  memcpy(c,in,VERIFY_PACKETS*188);
+  verify_decrypt(ref,b,od,ev);
+  for(i=1;i<VERIFY_PACKETS;i+=2){
+    memcpy(a+188*i,b+188*i,188);
   }
+  ok=ok&&verify_decrypt_multi(e,c,ev,od)&&memcmp(a,c,VERIFY_PACKETS*188)==0;
 
+  free(in);
+  free(a);
+  free(b);
+  free(c);
+  return ok;
 }
 
-//-----block utils
+//-----engine selection
 
-static inline __attribute__((always_inline)) void trasp_N_8 (unsigned char *in,unsigned char* out,int count){
-  int *ri=(int *)in;
-  int *ibi=(int *)out;
-  int j,i,k,g;
-  // copy and first step
-  for(g=0;g<count;g++){
-    ri[g]=ibi[2*g];
-    ri[GROUP_PARALLELISM+g]=ibi[2*g+1];
-  }
-//dump_mem("NE1 r[roff]",&r[roff],GROUP_PARALLELISM*8,GROUP_PARALLELISM);
-// now 01230123
-#define INTS_PER_ROW (GROUP_PARALLELISM/8*2)
-  for(j=0;j<8;j+=4){
-    for(i=0;i<2;i++){
-      for(k=0;k<INTS_PER_ROW;k++){
-        unsigned int t,b;
-        t=ri[INTS_PER_ROW*(j+i)+k];
-        b=ri[INTS_PER_ROW*(j+i+2)+k];
-        ri[INTS_PER_ROW*(j+i)+k]=     (t&0x0000ffff)      | ((b           )<<16);
-        ri[INTS_PER_ROW*(j+i+2)+k]=  ((t           )>>16) |  (b&0xffff0000) ;
-      }
-    }
+static const struct ffdecsa_engine *select_engine(void){
+  // the result never changes, so racing callers just compute it twice
+  static const struct ffdecsa_engine *selected=NULL;
+  const struct ffdecsa_engine *const *e;
+  unsigned int features;
+
+  if(selected!=NULL) return selected;
+  features=cpu_features();
+#ifdef PARALLEL_MODE
+  for(e=all_engines;*e!=NULL;e++){
+    if((*e)->mode==PARALLEL_MODE) break;
   }
-//dump_mem("NE2 r[roff]",&r[roff],GROUP_PARALLELISM*8,GROUP_PARALLELISM);
-// now 01010101
-  for(j=0;j<8;j+=2){
-    for(i=0;i<1;i++){
-      for(k=0;k<INTS_PER_ROW;k++){
-        unsigned int t,b;
-        t=ri[INTS_PER_ROW*(j+i)+k];
-        b=ri[INTS_PER_ROW*(j+i+1)+k];
-        ri[INTS_PER_ROW*(j+i)+k]=     (t&0x00ff00ff)     | ((b&0x00ff00ff)<<8);
-        ri[INTS_PER_ROW*(j+i+1)+k]=  ((t&0xff00ff00)>>8) |  (b&0xff00ff00);
-      }
-    }
+  if(*e!=NULL&&((*e)->cpu&~features)==0){
+    selected=*e;
+    return selected;
   }
-//dump_mem("NE3 r[roff]",&r[roff],GROUP_PARALLELISM*8,GROUP_PARALLELISM);
-// now 00000000
-}
-
-static inline __attribute__((always_inline)) void trasp_8_N (unsigned char *in,unsigned char* out,int count){
-  int *ri=(int *)in;
-  int *bdi=(int *)out;
-  int j,i,k,g;
-#define INTS_PER_ROW (GROUP_PARALLELISM/8*2)
-//dump_mem("NE1 r[roff]",&r[roff],GROUP_PARALLELISM*8,GROUP_PARALLELISM);
-// now 00000000
-  for(j=0;j<8;j+=2){
-    for(i=0;i<1;i++){
-      for(k=0;k<INTS_PER_ROW;k++){
-        unsigned int t,b;
-        t=ri[INTS_PER_ROW*(j+i)+k];
-        b=ri[INTS_PER_ROW*(j+i+1)+k];
-        ri[INTS_PER_ROW*(j+i)+k]=     (t&0x00ff00ff)     | ((b&0x00ff00ff)<<8);
-        ri[INTS_PER_ROW*(j+i+1)+k]=  ((t&0xff00ff00)>>8) |  (b&0xff00ff00);
-      }
-    }
+#endif
+  for(e=preferred_engines;*e!=NULL;e++){
+    if(((*e)->cpu&~features)==0&&verify_engine(*e)) break;
   }
-//dump_mem("NE2 r[roff]",&r[roff],GROUP_PARALLELISM*8,GROUP_PARALLELISM);
-// now 01010101
-  for(j=0;j<8;j+=4){
-    for(i=0;i<2;i++){
-      for(k=0;k<INTS_PER_ROW;k++){
-        unsigned int t,b;
-        t=ri[INTS_PER_ROW*(j+i)+k];
-        b=ri[INTS_PER_ROW*(j+i+2)+k];
-        ri[INTS_PER_ROW*(j+i)+k]=     (t&0x0000ffff)      | ((b           )<<16);
-        ri[INTS_PER_ROW*(j+i+2)+k]=  ((t           )>>16) |  (b&0xffff0000) ;
-      }
-    }
+  selected=(*e!=NULL)?*e:&ffdecsa_engine_032_int;
+  return selected;
+}
+
+//-----engine list, for tools comparing the engines
+
+const struct ffdecsa_engine *const *ffdecsa_engines(void){
+  return all_engines;
+}
+
+int ffdecsa_engine_usable(const struct ffdecsa_engine *e){
+  return (e->cpu&~cpu_features())==0&&verify_engine(e);
+}
+
+const struct ffdecsa_engine *ffdecsa_selected_engine(void){
+  return select_engine();
+}
+
+//-----worker pool for decrypt_packets_mt
+
+// a cluster split in chunks, each one decrypted by a single thread
+struct mt_chunk{
+  unsigned char *start;
+  unsigned char *end;
+};
+
+struct mt_job{
+  const struct ffdecsa_engine *engine;
+  void *keys;
+  struct mt_chunk *chunks;
+  int nchunks;
+  int next;      // first chunk not yet handed out
+  int done;      // chunks finished
+  int handled;   // packets handled in finished chunks
+  pthread_cond_t finished;
+  struct mt_job *next_job;
+};
+
+static pthread_once_t pool_once=PTHREAD_ONCE_INIT;
+static pthread_mutex_t pool_lock=PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t pool_work=PTHREAD_COND_INITIALIZER;
+static struct mt_job *pool_jobs=NULL;  // jobs with chunks still to hand out, oldest first
+static int pool_workers=0;
+
+static int mt_run_chunk(struct mt_job *job, struct mt_chunk *c){
+  unsigned char *cluster[3];
+  int handled=0;
+  cluster[0]=c->start;
+  cluster[1]=c->end;
+  cluster[2]=NULL;
+  while(cluster[0]!=NULL){
+    handled+=job->engine->decrypt_packets(job->keys,cluster);
   }
-//dump_mem("NE3 r[roff]",&r[roff],GROUP_PARALLELISM*8,GROUP_PARALLELISM);
-// now 01230123
-  for(g=0;g<count;g++){
-    bdi[2*g]=ri[g];
-    bdi[2*g+1]=ri[GROUP_PARALLELISM+g];
-  }
-}
-
-//-----block main function
-
-// block group
-static void block_decypher_group(
-  batch *kkmulti,       // [In]  kkmulti[0]-kkmulti[55] 56 batches | Key schedule (each batch has repeated equal bytes).
-  unsigned char *ib,    // [In]  (ib0,ib1,...ib7)...x32 32*8 bytes | Initialization vector.
-  unsigned char *bd,    // [Out] (bd0,bd1,...bd7)...x32 32*8 bytes | Block decipher.
-  int count)
-{
-  // int is faster than unsigned char. apparently not
-  static const unsigned char block_sbox[0x100] = {
-    0x3A,0xEA,0x68,0xFE,0x33,0xE9,0x88,0x1A, 0x83,0xCF,0xE1,0x7F,0xBA,0xE2,0x38,0x12,
-    0xE8,0x27,0x61,0x95,0x0C,0x36,0xE5,0x70, 0xA2,0x06,0x82,0x7C,0x17,0xA3,0x26,0x49,
-    0xBE,0x7A,0x6D,0x47,0xC1,0x51,0x8F,0xF3, 0xCC,0x5B,0x67,0xBD,0xCD,0x18,0x08,0xC9,
-    0xFF,0x69,0xEF,0x03,0x4E,0x48,0x4A,0x84, 0x3F,0xB4,0x10,0x04,0xDC,0xF5,0x5C,0xC6,
-    0x16,0xAB,0xAC,0x4C,0xF1,0x6A,0x2F,0x3C, 0x3B,0xD4,0xD5,0x94,0xD0,0xC4,0x63,0x62,
-    0x71,0xA1,0xF9,0x4F,0x2E,0xAA,0xC5,0x56, 0xE3,0x39,0x93,0xCE,0x65,0x64,0xE4,0x58,
-    0x6C,0x19,0x42,0x79,0xDD,0xEE,0x96,0xF6, 0x8A,0xEC,0x1E,0x85,0x53,0x45,0xDE,0xBB,
-    0x7E,0x0A,0x9A,0x13,0x2A,0x9D,0xC2,0x5E, 0x5A,0x1F,0x32,0x35,0x9C,0xA8,0x73,0x30,
-
-    0x29,0x3D,0xE7,0x92,0x87,0x1B,0x2B,0x4B, 0xA5,0x57,0x97,0x40,0x15,0xE6,0xBC,0x0E,
-    0xEB,0xC3,0x34,0x2D,0xB8,0x44,0x25,0xA4, 0x1C,0xC7,0x23,0xED,0x90,0x6E,0x50,0x00,
-    0x99,0x9E,0x4D,0xD9,0xDA,0x8D,0x6F,0x5F, 0x3E,0xD7,0x21,0x74,0x86,0xDF,0x6B,0x05,
-    0x8E,0x5D,0x37,0x11,0xD2,0x28,0x75,0xD6, 0xA7,0x77,0x24,0xBF,0xF0,0xB0,0x02,0xB7,
-    0xF8,0xFC,0x81,0x09,0xB1,0x01,0x76,0x91, 0x7D,0x0F,0xC8,0xA0,0xF2,0xCB,0x78,0x60,
-    0xD1,0xF7,0xE0,0xB5,0x98,0x22,0xB3,0x20, 0x1D,0xA6,0xDB,0x7B,0x59,0x9F,0xAE,0x31,
-    0xFB,0xD3,0xB6,0xCA,0x43,0x72,0x07,0xF4, 0xD8,0x41,0x14,0x55,0x0D,0x54,0x8B,0xB9,
-    0xAD,0x46,0x0B,0xAF,0x80,0x52,0x2C,0xFA, 0x8C,0x89,0x66,0xFD,0xB2,0xA9,0x9B,0xC0,
-  };
-  MEMALIGN unsigned char r[GROUP_PARALLELISM*(8+56)];  /* 56 because we will move back in memory while looping */
-  MEMALIGN unsigned char sbox_in[GROUP_PARALLELISM],sbox_out[GROUP_PARALLELISM],perm_out[GROUP_PARALLELISM];
-  int roff;
-  int i,g,count_all=GROUP_PARALLELISM;
-
-  roff=GROUP_PARALLELISM*56;
-
-#define FASTTRASP1
-#ifndef FASTTRASP1
-  for(g=0;g<count;g++){
-    // Init registers 
-    int j;
-    for(j=0;j<8;j++){
-      r[roff+GROUP_PARALLELISM*j+g]=ib[8*g+j];
+  return handled;
+}
+
+// all following mt_ functions are called with pool_lock held
+
+static void mt_unlink(struct mt_job *job){
+  struct mt_job **j;
+  for(j=&pool_jobs;*j!=NULL;j=&(*j)->next_job){
+    if(*j==job){
+      *j=job->next_job;
+      break;
     }
   }
-#else
-  trasp_N_8((unsigned char *)&r[roff],(unsigned char *)ib,count);
-#endif
-//dump_mem("OLD r[roff]",&r[roff],GROUP_PARALLELISM*8,GROUP_PARALLELISM);
-
-  // loop over kk[55]..kk[0]
-  for(i=55;i>=0;i--){
-    {
-      MEMALIGN batch tkkmulti=kkmulti[i];
-      batch *si=(batch *)sbox_in;
-      batch *r6_N=(batch *)(r+roff+GROUP_PARALLELISM*6);
-      for(g=0;g<count_all/BYTES_PER_BATCH;g++){
-        si[g]=B_FFXOR(tkkmulti,r6_N[g]);              //FIXME: introduce FASTBATCH?
-      }
-    }
+}
 
-    // table lookup, this works on only one byte at a time
-    // most difficult part of all
-    // - can't be parallelized
-    // - can't be synthetized through boolean terms (8 input bits are too many)
-    for(g=0;g<count_all;g++){
-      sbox_out[g]=block_sbox[sbox_in[g]];
-    }
+static void mt_append(struct mt_job *job){
+  struct mt_job **j;
+  for(j=&pool_jobs;*j!=NULL;j=&(*j)->next_job);
+  *j=job;
+}
 
-    // bit permutation
-    {
-      unsigned char *po=(unsigned char *)perm_out;
-      unsigned char *so=(unsigned char *)sbox_out;
-//dump_mem("pre perm ",(unsigned char *)so,GROUP_PARALLELISM,GROUP_PARALLELISM);
-      for(g=0;g<count_all;g+=BYTES_PER_BATCH){
-        MEMALIGN batch in,out;
-        in=*(batch *)&so[g];
-
-        out=B_FFOR(
-	    B_FFOR(
-	    B_FFOR(
-	    B_FFOR(
-	    B_FFOR(
-	           B_FFSH8L(B_FFAND(in,B_FFN_ALL_29()),1),
-	           B_FFSH8L(B_FFAND(in,B_FFN_ALL_02()),6)),
-	           B_FFSH8L(B_FFAND(in,B_FFN_ALL_04()),3)),
-	           B_FFSH8R(B_FFAND(in,B_FFN_ALL_10()),2)),
-	           B_FFSH8R(B_FFAND(in,B_FFN_ALL_40()),6)),
-	           B_FFSH8R(B_FFAND(in,B_FFN_ALL_80()),4));
-
-        *(batch *)&po[g]=out;
-      }
-//dump_mem("post perm",(unsigned char *)po,GROUP_PARALLELISM,GROUP_PARALLELISM);
-    }
+// hand out the next chunk of job, -1 if there are none left
+static int mt_take(struct mt_job *job){
+  int i;
+  if(job->next>=job->nchunks) return -1;
+  i=job->next++;
+  if(job->next==job->nchunks) mt_unlink(job);
+  return i;
+}
 
-    roff-=GROUP_PARALLELISM; /* virtual shift of registers */
+static void mt_finish(struct mt_job *job, int handled){
+  job->handled+=handled;
+  job->done++;
+  if(job->done==job->nchunks) pthread_cond_signal(&job->finished);
+}
 
-#if 0
-/* one by one */
-    for(g=0;g<count_all;g++){
-      r[roff+GROUP_PARALLELISM*0+g]=r[roff+GROUP_PARALLELISM*8+g]^sbox_out[g];
-      r[roff+GROUP_PARALLELISM*6+g]^=perm_out[g];
-      r[roff+GROUP_PARALLELISM*4+g]^=r[roff+GROUP_PARALLELISM*0+g];
-      r[roff+GROUP_PARALLELISM*3+g]^=r[roff+GROUP_PARALLELISM*0+g];
-      r[roff+GROUP_PARALLELISM*2+g]^=r[roff+GROUP_PARALLELISM*0+g];
-    }
-#else
-    for(g=0;g<count_all;g+=BEST_SPAN){
-      XOR_BEST_BY(&r[roff+GROUP_PARALLELISM*0+g],&r[roff+GROUP_PARALLELISM*8+g],&sbox_out[g]);
-      XOREQ_BEST_BY(&r[roff+GROUP_PARALLELISM*6+g],&perm_out[g]);
-      XOREQ_BEST_BY(&r[roff+GROUP_PARALLELISM*4+g],&r[roff+GROUP_PARALLELISM*0+g]);
-      XOREQ_BEST_BY(&r[roff+GROUP_PARALLELISM*3+g],&r[roff+GROUP_PARALLELISM*0+g]);
-      XOREQ_BEST_BY(&r[roff+GROUP_PARALLELISM*2+g],&r[roff+GROUP_PARALLELISM*0+g]);
-    }
-#endif
+static void *mt_worker(void *arg){
+  struct mt_job *job;
+  int i,handled;
+  (void)arg;
+  pthread_mutex_lock(&pool_lock);
+  for(;;){
+    while(pool_jobs==NULL){
+      pthread_cond_wait(&pool_work,&pool_lock);
+    }
+    job=pool_jobs;
+    i=mt_take(job);
+    pthread_mutex_unlock(&pool_lock);
+    handled=mt_run_chunk(job,&job->chunks[i]);
+    pthread_mutex_lock(&pool_lock);
+    mt_finish(job,handled);
   }
+  return NULL;
+}
 
-#define FASTTRASP2
-#ifndef FASTTRASP2
-  for(g=0;g<count;g++){
-    // Copy results
-    int j;
-    for(j=0;j<8;j++){
-      bd[8*g+j]=r[roff+GROUP_PARALLELISM*j+g];
-    }
+static void mt_start_pool(void){
+  // the calling thread always works too
+  long cpus=sysconf(_SC_NPROCESSORS_ONLN);
+  int i;
+  for(i=0;i<cpus-1;i++){
+    pthread_t t;
+    if(pthread_create(&t,NULL,mt_worker,NULL)!=0) break;
+    pthread_detach(t);
   }
-#else
-  trasp_8_N((unsigned char *)&r[roff],(unsigned char *)bd,count);
-#endif
+  pool_workers=i;
 }
 
 //-----------------------------------EXTERNAL INTERFACE
 
+// control words are double buffered: a change schedules the new key into
+// the slot nobody decrypts with, then flips current. Decryption never
+// waits for a change and never sees half a schedule; a change waits only
+// for decrypt calls still using the slot it is about to rewrite, which
+// started before the previous change.
+struct ffdecsa_keys_t{
+  const struct ffdecsa_engine *engine;
+  void *slot[2];            // engine key structures
+  volatile int current;     // slot new decrypt calls use
+  volatile int readers[2];  // decrypt calls running on each slot
+  pthread_mutex_t writer;   // one control word change at a time
+};
+
+// the slot to decrypt with, released by release_slot()
+static int acquire_slot(struct ffdecsa_keys_t *k){
+  int s;
+  for(;;){
+    s=__sync_fetch_and_add(&k->current,0);
+    __sync_fetch_and_add(&k->readers[s],1);
+    if(__sync_fetch_and_add(&k->current,0)==s) return s;
+    // flipped meanwhile, the writer may be rewriting it
+    __sync_fetch_and_sub(&k->readers[s],1);
+  }
+}
+
+static void release_slot(struct ffdecsa_keys_t *k, int s){
+  __sync_fetch_and_sub(&k->readers[s],1);
+}
+
+// NULL keeps that word
+static void publish_control_words(struct ffdecsa_keys_t *k, const unsigned char *ev, const unsigned char *od){
+  unsigned char cur_ev[8],cur_od[8];
+  int cur,spare;
+  pthread_mutex_lock(&k->writer);
+  cur=__sync_fetch_and_add(&k->current,0);
+  spare=1-cur;
+  while(__sync_fetch_and_add(&k->readers[spare],0)!=0){
+    sched_yield();
+  }
+  k->engine->get_control_words(k->slot[cur],cur_ev,cur_od);
+  k->engine->set_even_control_word(k->slot[spare],ev!=NULL?ev:cur_ev);
+  k->engine->set_odd_control_word(k->slot[spare],od!=NULL?od:cur_od);
+  // full barrier, the schedule is complete before anyone can pick it
+  __sync_bool_compare_and_swap(&k->current,cur,spare);
+  pthread_mutex_unlock(&k->writer);
+}
+
 //-----get internal parallelism
 
 int get_internal_parallelism(void){
-  return GROUP_PARALLELISM;
+  return select_engine()->parallelism;
 }
 
 //-----get suggested cluster size
 
 int get_suggested_cluster_size(void){
+  int p=get_internal_parallelism();
   int r;
-  r=GROUP_PARALLELISM+GROUP_PARALLELISM/10;
-  if(r<GROUP_PARALLELISM+5) r=GROUP_PARALLELISM+5;
+  r=p+p/10;
+  if(r<p+5) r=p+5;
   return r;
 }
 
 //-----key structure
 
 void *get_key_struct(void){
-  struct csa_keys_t *keys=(struct csa_keys_t *)MALLOC(sizeof(struct csa_keys_t));
-  if(keys) {
-    static const unsigned char pk[8] = { 0,0,0,0,0,0,0,0 };
-    set_control_words(keys,pk,pk);
-    }
-  return keys;
+  struct ffdecsa_keys_t *k=(struct ffdecsa_keys_t *)malloc(sizeof(struct ffdecsa_keys_t));
+  if(k){
+    k->engine=select_engine();
+    k->slot[0]=k->engine->get_key_struct();
+    k->slot[1]=k->engine->get_key_struct();
+    if(k->slot[0]==NULL||k->slot[1]==NULL){
+      if(k->slot[0]!=NULL) k->engine->free_key_struct(k->slot[0]);
+      if(k->slot[1]!=NULL) k->engine->free_key_struct(k->slot[1]);
+      free(k);
+      return NULL;
+    }
+    k->current=0;
+    k->readers[0]=0;
+    k->readers[1]=0;
+    pthread_mutex_init(&k->writer,NULL);
+  }
+  return k;
 }
 
 void free_key_struct(void *keys){
-  return FREE(keys);
+  struct ffdecsa_keys_t *k=(struct ffdecsa_keys_t *)keys;
+  if(k){
+    pthread_mutex_destroy(&k->writer);
+    k->engine->free_key_struct(k->slot[0]);
+    k->engine->free_key_struct(k->slot[1]);
+    free(k);
+  }
 }
 
 //-----set control words
 
-static void schedule_key(struct csa_key_t *key, const unsigned char *pk){
-  // could be made faster, but is not run often
-  int bi,by;
-  int i,j;
-// key
-  memcpy(key->ck,pk,8);
-// precalculations for stream
-  key_schedule_stream(key->ck,key->iA,key->iB);
-  for(by=0;by<8;by++){
-    for(bi=0;bi<8;bi++){
-      key->ck_g[by][bi]=(key->ck[by]&(1<<bi))?FF1():FF0();
-    }
-  }
-  for(by=0;by<8;by++){
-    for(bi=0;bi<4;bi++){
-      key->iA_g[by][bi]=(key->iA[by]&(1<<bi))?FF1():FF0();
-      key->iB_g[by][bi]=(key->iB[by]&(1<<bi))?FF1():FF0();
-    }
-  }
-// precalculations for block
-  key_schedule_block(key->ck,key->kk);
-  for(i=0;i<56;i++){
-    for(j=0;j<BYTES_PER_BATCH;j++){
-      *(((unsigned char *)&key->kkmulti[i])+j)=key->kk[i];
-    }
-  }
-}
-
 void set_control_words(void *keys, const unsigned char *ev, const unsigned char *od){
-  schedule_key(&((struct csa_keys_t *)keys)->even,ev);
-  schedule_key(&((struct csa_keys_t *)keys)->odd,od);
+  publish_control_words((struct ffdecsa_keys_t *)keys,ev,od);
 }
 
 void set_even_control_word(void *keys, const unsigned char *pk){
-  schedule_key(&((struct csa_keys_t *)keys)->even,pk);
+  publish_control_words((struct ffdecsa_keys_t *)keys,pk,NULL);
 }
 
 void set_odd_control_word(void *keys, const unsigned char *pk){
-  schedule_key(&((struct csa_keys_t *)keys)->odd,pk);
+  publish_control_words((struct ffdecsa_keys_t *)keys,NULL,pk);
 }
 
 //-----get control words
 
 void get_control_words(void *keys, unsigned char *even, unsigned char *odd){
-  memcpy(even,&((struct csa_keys_t *)keys)->even.ck,8);
-  memcpy(odd,&((struct csa_keys_t *)keys)->odd.ck,8);
+  struct ffdecsa_keys_t *k=(struct ffdecsa_keys_t *)keys;
+  int s=acquire_slot(k);
+  k->engine->get_control_words(k->slot[s],even,odd);
+  release_slot(k,s);
 }
 
 //----- decrypt
 
 int decrypt_packets(void *keys, unsigned char **cluster){
-  // statistics, currently unused
-  int stat_no_scramble=0;
-  int stat_reserved=0;
-  int stat_decrypted[2]={0,0};
-  int stat_decrypted_mini=0;
-  unsigned char **clst;
-  unsigned char **clst2;
-  int grouped;
-  int group_ev_od;
-  int advanced;
-  int can_advance;
-  unsigned char *g_pkt[GROUP_PARALLELISM];
-  int g_len[GROUP_PARALLELISM];
-  int g_offset[GROUP_PARALLELISM];
-  int g_n[GROUP_PARALLELISM];
-  int g_residue[GROUP_PARALLELISM];
-  unsigned char *pkt;
-  int xc0,ev_od,len,offset,n,residue;
-  struct csa_key_t* k;
-  int i,j,iter,g;
-  int t23,tsmall;
-  int alive[24];
-//icc craziness  int pad1=0; //////////align! FIXME
-  unsigned char *encp[GROUP_PARALLELISM];
-  unsigned char stream_in[GROUP_PARALLELISM*8];
-  unsigned char stream_out[GROUP_PARALLELISM*8];
-  MEMALIGN unsigned char ib[GROUP_PARALLELISM*8];
-  MEMALIGN unsigned char block_out[GROUP_PARALLELISM*8];
-  struct stream_regs regs;
-
-//icc craziness  i=(int)&pad1;//////////align!!! FIXME
-
-  // build a list of packets to be processed
-  clst=cluster;
-  grouped=0;
-  advanced=0;
-  can_advance=1;
-  group_ev_od=-1; // silence incorrect compiler warning
-  pkt=*clst;
-  do{ // find a new packet
-    if(grouped==GROUP_PARALLELISM){
-      // full
-      break;
-    }
-    if(pkt==NULL){
-      // no more ranges
-      break;
-    }
-    if(pkt>=*(clst+1)){
-      // out of this range, try next
-      clst++;clst++;
-      pkt=*clst;
-      continue;
-    }
+  struct ffdecsa_keys_t *k=(struct ffdecsa_keys_t *)keys;
+  int s=acquire_slot(k);
+  int advanced=k->engine->decrypt_packets(k->slot[s],cluster);
+  release_slot(k,s);
+  return advanced;
+}
 
-    do{ // handle this packet
-      xc0=pkt[3]&0xc0;
-      DBG(fprintf(stderr,"   exam pkt=%p, xc0=%02x, can_adv=%i\n",pkt,xc0,can_advance));
-      if(xc0==0x00){
-        DBG(fprintf(stderr,"skip clear pkt %p (can_advance is %i)\n",pkt,can_advance));
-        advanced+=can_advance;
-        stat_no_scramble++;
-        break;
-      }
-      if(xc0==0x40){
-        DBG(fprintf(stderr,"skip reserved pkt %p (can_advance is %i)\n",pkt,can_advance));
-        advanced+=can_advance;
-        stat_reserved++;
-        break;
-      }
-      if(xc0==0x80||xc0==0xc0){ // encrypted
-        ev_od=(xc0&0x40)>>6; // 0 even, 1 odd
-        if(grouped==0) group_ev_od=ev_od; // this group will be all even (or odd)
-        if(group_ev_od==ev_od){ // could be added to group
-          pkt[3]&=0x3f;  // consider it decrypted now
-          if(pkt[3]&0x20){ // incomplete packet
-            offset=4+pkt[4]+1;
-            len=188-offset;
-            n=len>>3;
-            residue=len-(n<<3);
-            if(n==0){ // decrypted==encrypted!
-              DBG(fprintf(stderr,"DECRYPTED MINI! (can_advance is %i)\n",can_advance));
-              advanced+=can_advance;
-              stat_decrypted_mini++;
-              break; // this doesn't need more processing
-            }
-          }else{
-            len=184;
-            offset=4;
-            n=23;
-            residue=0;
-          }
-          g_pkt[grouped]=pkt;
-          g_len[grouped]=len;
-          g_offset[grouped]=offset;
-          g_n[grouped]=n;
-          g_residue[grouped]=residue;
-          DBG(fprintf(stderr,"%2i: eo=%i pkt=%p len=%03i n=%2i residue=%i\n",grouped,ev_od,pkt,len,n,residue));
-          grouped++;
-          advanced+=can_advance;
-          stat_decrypted[ev_od]++;
-        }
-        else{
-          can_advance=0;
-          DBG(fprintf(stderr,"skip pkt %p and can_advance set to 0\n",pkt));
-          break; // skip and go on
-        }
+//----- decrypt, packet pointers
+
+// packets per cluster built from the pointer array, enough to fill an even
+// and an odd group of the widest engine
+#define IOV_CHUNK 512
+
+int decrypt_packets_iov(void *keys, unsigned char **src, unsigned char **dst, int n){
+  struct ffdecsa_keys_t *k=(struct ffdecsa_keys_t *)keys;
+  unsigned char *cluster[2*IOV_CHUNK+1];
+  int s=acquire_slot(k);
+  int i,j,c;
+  for(i=0;i<n;i+=c){
+    c=n-i;
+    if(c>IOV_CHUNK) c=IOV_CHUNK;
+    // one range per packet, the engine doesn't care they aren't contiguous
+    for(j=0;j<c;j++){
+      unsigned char *pkt=src[i+j];
+      if(dst!=NULL&&dst[i+j]!=pkt){
+        memcpy(dst[i+j],pkt,188);
+        pkt=dst[i+j];
       }
-    } while(0);
-
-    if(can_advance){
-      // move range start forward
-      *clst+=188;
+      cluster[2*j]=pkt;
+      cluster[2*j+1]=pkt+188;
     }
-    // next packet, if there is one
-    pkt+=188;
-  } while(1);
-  DBG(fprintf(stderr,"-- result: grouped %i pkts, advanced %i pkts\n",grouped,advanced));
-
-  // delete empty ranges and compact list
-  clst2=cluster;
-  for(clst=cluster;*clst!=NULL;clst+=2){
-    // if not empty
-    if(*clst<*(clst+1)){
-      // it will remain 
-      *clst2=*clst;
-      *(clst2+1)=*(clst+1);
-      clst2+=2;
+    cluster[2*c]=NULL;
+    while(cluster[0]!=NULL){
+      k->engine->decrypt_packets(k->slot[s],cluster);
     }
   }
-  *clst2=NULL;
-
-  if(grouped==0){
-    // no processing needed
-    return advanced;
-  }
+  release_slot(k,s);
+  return n;
+}
 
-  //  sort them, longest payload first
-  //  we expect many n=23 packets and a few n<23
-  DBG(fprintf(stderr,"PRESORTING\n"));
-  for(i=0;i<grouped;i++){
-    DBG(fprintf(stderr,"%2i of %2i: pkt=%p len=%03i n=%2i residue=%i\n",i,grouped,g_pkt[i],g_len[i],g_n[i],g_residue[i]));
-    }
-  // grouped is always <= GROUP_PARALLELISM
-
-#define g_swap(a,b) \
-    pkt=g_pkt[a]; \
-    g_pkt[a]=g_pkt[b]; \
-    g_pkt[b]=pkt; \
-\
-    len=g_len[a]; \
-    g_len[a]=g_len[b]; \
-    g_len[b]=len; \
-\
-    offset=g_offset[a]; \
-    g_offset[a]=g_offset[b]; \
-    g_offset[b]=offset; \
-\
-    n=g_n[a]; \
-    g_n[a]=g_n[b]; \
-    g_n[b]=n; \
-\
-    residue=g_residue[a]; \
-    g_residue[a]=g_residue[b]; \
-    g_residue[b]=residue;
-
-  // step 1: move n=23 packets before small packets
-  t23=0;
-  tsmall=grouped-1;
-  for(;;){
-    for(;t23<grouped;t23++){
-      if(g_n[t23]!=23) break;
-    }
-DBG(fprintf(stderr,"t23 after for =%i\n",t23));
-    
-    for(;tsmall>=0;tsmall--){
-      if(g_n[tsmall]==23) break;
-    }
-DBG(fprintf(stderr,"tsmall after for =%i\n",tsmall));
-    
-    if(tsmall-t23<1) break;
-    
-DBG(fprintf(stderr,"swap t23=%i,tsmall=%i\n",t23,tsmall));
-
-    g_swap(t23,tsmall);
-
-    t23++;
-    tsmall--;
-DBG(fprintf(stderr,"new t23=%i,tsmall=%i\n\n",t23,tsmall));
-  }
-  DBG(fprintf(stderr,"packets with n=23, t23=%i   grouped=%i\n",t23,grouped));
-  DBG(fprintf(stderr,"MIDSORTING\n"));
-  for(i=0;i<grouped;i++){
-    DBG(fprintf(stderr,"%2i of %2i: pkt=%p len=%03i n=%2i residue=%i\n",i,grouped,g_pkt[i],g_len[i],g_n[i],g_residue[i]));
-    }
+//----- decrypt, a key per range
 
-  // step 2: sort small packets in decreasing order of n (bubble sort is enough)
-  for(i=t23;i<grouped;i++){
-    for(j=i+1;j<grouped;j++){
-      if(g_n[j]>g_n[i]){
-        g_swap(i,j);
-      }
-    }
+int decrypt_packets_multi(void **keys, int nkeys, unsigned char **cluster, int *cluster_keys){
+  void *engine_keys[MAX_KEYS];
+  int slots[MAX_KEYS];
+  const struct ffdecsa_engine *engine=select_engine();
+  int i,advanced;
+  if(nkeys<1||nkeys>MAX_KEYS) return -1;
+  for(i=0;cluster[2*i]!=NULL;i++){
+    if(cluster_keys[i]<0||cluster_keys[i]>=nkeys) return -1;
   }
-  DBG(fprintf(stderr,"POSTSORTING\n"));
-  for(i=0;i<grouped;i++){
-    DBG(fprintf(stderr,"%2i of %2i: pkt=%p len=%03i n=%2i residue=%i\n",i,grouped,g_pkt[i],g_len[i],g_n[i],g_residue[i]));
-    }
-
-  // we need to know how many packets need 23 iterations, how many 22...
-  for(i=0;i<=23;i++){
-    alive[i]=0;
+  for(i=0;i<nkeys;i++){
+    struct ffdecsa_keys_t *k=(struct ffdecsa_keys_t *)keys[i];
+    slots[i]=acquire_slot(k);
+    engine_keys[i]=k->slot[slots[i]];
+  }
+  advanced=engine->decrypt_packets_multi(engine_keys,cluster,cluster_keys);
+  for(i=0;i<nkeys;i++){
+    release_slot((struct ffdecsa_keys_t *)keys[i],slots[i]);
   }
-  // count
-  alive[23-1]=t23;
-  for(i=t23;i<grouped;i++){
-    alive[g_n[i]-1]++;
+  return advanced;
+}
+
+int decrypt_packets_iov_multi(void **keys, int nkeys, unsigned char **src, const int *src_keys, int n){
+  unsigned char *cluster[2*IOV_CHUNK+1];
+  int cluster_keys[IOV_CHUNK];
+  void *engine_keys[MAX_KEYS];
+  int slots[MAX_KEYS];
+  const struct ffdecsa_engine *engine=select_engine();
+  int i,j,c;
+  if(nkeys<1||nkeys>MAX_KEYS) return -1;
+  for(i=0;i<n;i++){
+    if(src_keys[i]<0||src_keys[i]>=nkeys) return -1;
   }
-  // integrate
-  for(i=22;i>=0;i--){
-    alive[i]+=alive[i+1];
+  for(i=0;i<nkeys;i++){
+    struct ffdecsa_keys_t *k=(struct ffdecsa_keys_t *)keys[i];
+    slots[i]=acquire_slot(k);
+    engine_keys[i]=k->slot[slots[i]];
   }
-  DBG(fprintf(stderr,"ALIVE\n"));
-  for(i=0;i<=23;i++){
-    DBG(fprintf(stderr,"alive%2i=%i\n",i,alive[i]));
+  for(i=0;i<n;i+=c){
+    c=n-i;
+    if(c>IOV_CHUNK) c=IOV_CHUNK;
+    for(j=0;j<c;j++){
+      cluster[2*j]=src[i+j];
+      cluster[2*j+1]=src[i+j]+188;
+      cluster_keys[j]=src_keys[i+j];
+    }
+    cluster[2*c]=NULL;
+    while(cluster[0]!=NULL){
+      engine->decrypt_packets_multi(engine_keys,cluster,cluster_keys);
     }
-
-  // choose key
-  if(group_ev_od==0){
-    k=&((struct csa_keys_t *)keys)->even;
   }
-  else{
-    k=&((struct csa_keys_t *)keys)->odd;
+  for(i=0;i<nkeys;i++){
+    release_slot((struct ffdecsa_keys_t *)keys[i],slots[i]);
   }
+  return n;
+}
 
-  //INIT
-//#define INITIALIZE_UNUSED_INPUT
-#ifdef INITIALIZE_UNUSED_INPUT
-// unnecessary zeroing.
-// without this, we operate on uninitialized memory
-// when grouped<GROUP_PARALLELISM, but it's not a problem,
-// as final results will be discarded.
-// random data makes debugging sessions difficult.
-  for(j=0;j<GROUP_PARALLELISM*8;j++) stream_in[j]=0;
-DBG(fprintf(stderr,"--- WARNING: you could gain speed by not initializing unused memory ---\n"));
-#else
-DBG(fprintf(stderr,"--- WARNING: DEBUGGING IS MORE DIFFICULT WHEN PROCESSING RANDOM DATA CHANGING AT EVERY RUN! ---\n"));
-#endif
+//----- decrypt on all cpus
 
-  for(g=0;g<grouped;g++){
-    encp[g]=g_pkt[g];
-    DBG(fprintf(stderr,"header[%i]=%p (%02x)\n",g,encp[g],*(encp[g])));
-    encp[g]+=g_offset[g]; // skip header
-    FFTABLEIN(stream_in,g,encp[g]);
-  }
-//dump_mem("stream_in",stream_in,GROUP_PARALLELISM*8,BYPG);
-
-
-  // ITER 0
-DBG(fprintf(stderr,">>>>>ITER 0\n"));
-  iter=0;
-  stream_cypher_group_init(&regs,k->iA_g,k->iB_g,stream_in);
-  // fill first ib
-  for(g=0;g<alive[iter];g++){
-    COPY_8_BY(ib+8*g,encp[g]);
-  }
-DBG(dump_mem("IB ",ib,8*alive[iter],8));
-  // ITER 1..N-1
-  for (iter=1;iter<23&&alive[iter-1]>0;iter++){
-DBG(fprintf(stderr,">>>>>ITER %i\n",iter));
-    // alive and just dead packets: calc block
-    block_decypher_group(k->kkmulti,ib,block_out,alive[iter-1]);
-DBG(dump_mem("BLO_ib ",block_out,8*alive[iter-1],8));
-    // all packets (dead too): calc stream
-    stream_cypher_group_normal(&regs,stream_out);
-//dump_mem("stream_out",stream_out,GROUP_PARALLELISM*8,BYPG);
-
-    // alive packets: calc ib
-    for(g=0;g<alive[iter];g++){
-      FFTABLEOUT(ib+8*g,stream_out,g);
-DBG(dump_mem("stream_out_ib ",ib+8*g,8,8));
-// XOREQ8BY gcc bug? 2x4 ok, 8 ko    UPDATE: result ok but speed 1-2% slower (!!!???)
-#if 1
-      XOREQ_4_BY(ib+8*g,encp[g]+8);
-      XOREQ_4_BY(ib+8*g+4,encp[g]+8+4);
-#else
-      XOREQ_8_BY(ib+8*g,encp[g]+8);
-#endif
-DBG(dump_mem("after_stream_xor_ib ",ib+8*g,8,8));
-    }
-    // alive packets: decrypt data
-    for(g=0;g<alive[iter];g++){
-DBG(dump_mem("before_ib_decrypt_data ",encp[g],8,8));
-      XOR_8_BY(encp[g],ib+8*g,block_out+8*g);
-DBG(dump_mem("after_ib_decrypt_data ",encp[g],8,8));
-    }
-    // just dead packets: write decrypted data
-    for(g=alive[iter];g<alive[iter-1];g++){
-DBG(dump_mem("jd_before_ib_decrypt_data ",encp[g],8,8));
-      COPY_8_BY(encp[g],block_out+8*g);
-DBG(dump_mem("jd_after_ib_decrypt_data ",encp[g],8,8));
-    }
-    // just dead packets: decrypt residue
-    for(g=alive[iter];g<alive[iter-1];g++){
-DBG(dump_mem("jd_before_decrypt_residue ",encp[g]+8,g_residue[g],g_residue[g]));
-      FFTABLEOUTXORNBY(g_residue[g],encp[g]+8,stream_out,g);
-DBG(dump_mem("jd_after_decrypt_residue ",encp[g]+8,g_residue[g],g_residue[g]));
+int decrypt_packets_mt(void *keys, unsigned char **cluster){
+  struct ffdecsa_keys_t *k=(struct ffdecsa_keys_t *)keys;
+  struct mt_job job;
+  unsigned char **c;
+  int packets,chunk,i,handled,s;
+
+  pthread_once(&pool_once,mt_start_pool);
+
+  packets=0;
+  for(c=cluster;*c!=NULL;c+=2){
+    packets+=(*(c+1)-*c)/188;
+  }
+  // a few chunks per thread to even out the load, whole groups each
+  chunk=packets/(4*(pool_workers+1));
+  if(chunk<2*k->engine->parallelism) chunk=2*k->engine->parallelism;
+  chunk=(chunk+k->engine->parallelism-1)/k->engine->parallelism*k->engine->parallelism;
+
+  job.chunks=NULL;
+  job.nchunks=0;
+  if(pool_workers>0&&packets>chunk){
+    for(c=cluster;*c!=NULL;c+=2){
+      job.nchunks+=((*(c+1)-*c)/188+chunk-1)/chunk;
+    }
+    job.chunks=(struct mt_chunk *)malloc(job.nchunks*sizeof(struct mt_chunk));
+  }
+  s=acquire_slot(k);
+  if(job.chunks==NULL){
+    // not worth it (or no memory), do it here
+    handled=0;
+    while(*cluster!=NULL){
+      handled+=k->engine->decrypt_packets(k->slot[s],cluster);
+    }
+    release_slot(k,s);
+    return handled;
+  }
+
+  i=0;
+  for(c=cluster;*c!=NULL;c+=2){
+    unsigned char *p;
+    for(p=*c;p<*(c+1);p+=188*chunk){
+      job.chunks[i].start=p;
+      job.chunks[i].end=(*(c+1)-p>188*chunk)?p+188*chunk:*(c+1);
+      i++;
     }
-    // alive packets: pointers++
-    for(g=0;g<alive[iter];g++) encp[g]+=8;
-  };
-  // ITER N
-DBG(fprintf(stderr,">>>>>ITER 23\n"));
-  iter=23;
-  // calc block
-  block_decypher_group(k->kkmulti,ib,block_out,alive[iter-1]);
-DBG(dump_mem("23BLO_ib ",block_out,8*alive[iter-1],8));
-  // just dead packets: write decrypted data
-  for(g=alive[iter];g<alive[iter-1];g++){
-DBG(dump_mem("23jd_before_ib_decrypt_data ",encp[g],8,8));
-    COPY_8_BY(encp[g],block_out+8*g);
-DBG(dump_mem("23jd_after_ib_decrypt_data ",encp[g],8,8));
-  }
-  // no residue possible
-  // so do nothing
-
-  DBG(fprintf(stderr,"returning advanced=%i\n",advanced));
-
-  M_EMPTY(); // restore CPU multimedia state
+  }
+  job.engine=k->engine;
+  job.keys=k->slot[s];
+  job.next=0;
+  job.done=0;
+  job.handled=0;
+  job.next_job=NULL;
+  pthread_cond_init(&job.finished,NULL);
+
+  pthread_mutex_lock(&pool_lock);
+  mt_append(&job);
+  pthread_cond_broadcast(&pool_work);
+  // help with our own chunks, then wait for the ones the workers took
+  while((i=mt_take(&job))>=0){
+    pthread_mutex_unlock(&pool_lock);
+    handled=mt_run_chunk(&job,&job.chunks[i]);
+    pthread_mutex_lock(&pool_lock);
+    mt_finish(&job,handled);
+  }
+  while(job.done<job.nchunks){
+    pthread_cond_wait(&job.finished,&pool_lock);
+  }
+  pthread_mutex_unlock(&pool_lock);
 
-  return advanced;
+  release_slot(k,s);
+  pthread_cond_destroy(&job.finished);
+  free(job.chunks);
+  *cluster=NULL;
+  return job.handled;
 }
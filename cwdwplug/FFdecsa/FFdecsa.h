@@ -43,6 +43,8 @@ void *get_key_struct(void);
 void free_key_struct(void *keys);
 
 // -- set control words, 8 bytes each
+// Safe while other threads decrypt with the same key structure: calls
+// already running finish with the old words, later ones use the new.
 void set_control_words(void *keys, const unsigned char *even, const unsigned char *odd);
 
 // -- set even control word, 8 bytes
@@ -59,4 +61,39 @@ void set_odd_control_word(void *keys, const unsigned char *odd);
 // Please read doc/how_to_use.txt.
 int decrypt_packets(void *keys, unsigned char **cluster);
 
+// -- decrypt many TS packets on all cpus
+// Same cluster format as decrypt_packets, but the whole cluster is done
+// before returning: it is split in chunks that a pool of worker threads
+// (one less than the online cpus, the caller works too) decrypts with
+// their own bitsliced groups. On return every range has been consumed and
+// cluster[0] is NULL; the return value is the number of packets handled.
+// The control words in effect when the call starts are used throughout.
+int decrypt_packets_mt(void *keys, unsigned char **cluster);
+
+// -- decrypt TS packets given one pointer per packet
+// src[0..n-1] point to 188 byte packets, anywhere in memory. With dst NULL
+// they are decrypted in place, otherwise dst[i] receives packet src[i]
+// decrypted (clear packets are copied as they are) and src is left alone;
+// dst[i] may be src[i]. All n packets are done before returning, the
+// return value is n.
+int decrypt_packets_iov(void *keys, unsigned char **src, unsigned char **dst, int n);
+
+// -- decrypt TS packets of several services at once
+// keys[0..nkeys-1] are key structures, one per service, nkeys from 1 up to
+// MAX_KEYS. The cluster is as for decrypt_packets; range i (cluster[2*i] up
+// to cluster[2*i+1]) is decrypted with keys[cluster_keys[i]], even or odd
+// word by packet. Every packet of a group can have a different key, so a
+// whole multiplex fills the groups. cluster_keys is compacted together with
+// the ranges. Any other nkeys, or a key index outside 0..nkeys-1, returns -1
+// and leaves the cluster alone.
+#define MAX_KEYS 16
+int decrypt_packets_multi(void **keys, int nkeys, unsigned char **cluster, int *cluster_keys);
+
+// -- decrypt TS packets of several services given one pointer per packet
+// As decrypt_packets_iov, in place, with packet src[i] decrypted with
+// keys[src_keys[i]]. All n packets are done before returning, the return
+// value is n, or -1 for nkeys or a key index out of range as above, with
+// no packet touched.
+int decrypt_packets_iov_multi(void **keys, int nkeys, unsigned char **src, const int *src_keys, int n);
+
 #endif
@@ -0,0 +1,293 @@
+/* FFdecsa -- fast decsa algorithm
+ *
+ * Copyright (C) 2003-2004  fatih89r
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+//// throughput of every engine on synthetic or recorded transport streams.
+//// Not part of the plugin, build it on linux with
+////
+////   g++ -O3 -o FFdecsa_bench FFdecsa_bench.cc FFdecsa.cc engine_*.cc -lpthread
+////
+//// and run it with -h for the options. For each engine it prints
+////   Mbps      payload of all packets (clear ones too) per second
+////   pkt/s     packets per second
+////   eff       packets handled per decrypt_packets call, in percent of
+////             the engine parallelism (as SHOW_SPEED_STATISTICS in the
+////             plugin); a call fills an even and an odd group, so it can
+////             go above 100 near parity changes
+////   cyc/pkt   time stamp counter ticks per packet (x86 only)
+
+#include <sys/types.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+
+#include "FFdecsa.h"
+#include "FFdecsa_engine.h"
+
+#ifdef FFDECSA_X86
+#include <x86intrin.h>
+#endif
+
+struct bench_opts{
+  int packets;        // packets in the synthetic stream
+  int cluster;        // packets per cluster, 0 = suggested size of each engine
+  int scrambled;      // percent of scrambled packets
+  int adaptation;     // percent of packets with an adaptation field
+  int max_af;         // adaptation field length, uniform in 0..max_af
+  double flips;       // parity changes per second of stream
+  double rate;        // stream rate in Mbps, to turn flips into packets
+  double seconds;     // measuring time per engine
+  const char *engine; // only engines whose name contains this
+  const char *file;   // replay this .ts instead
+};
+
+static double now(void){
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC,&ts);
+  return ts.tv_sec+ts.tv_nsec*1e-9;
+}
+
+static unsigned long long ticks(void){
+#ifdef FFDECSA_X86
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+static void usage(const char *prog){
+  fprintf(stderr,
+    "usage: %s [options]\n"
+    "  -p packets     packets in the synthetic stream (50000)\n"
+    "  -c cluster     packets per decrypt_packets cluster, 0 = suggested (0)\n"
+    "  -s percent     scrambled packets (90)\n"
+    "  -a percent     packets with an adaptation field (10)\n"
+    "  -A length      longest adaptation field, 0..183 (183)\n"
+    "  -f flips       parity changes per second of stream (0.1)\n"
+    "  -r mbps        stream rate used for -f (40)\n"
+    "  -t seconds     measuring time per engine (2)\n"
+    "  -e name        only engines whose name contains this\n"
+    "  -i file.ts     replay a recorded stream instead of generating one\n",
+    prog);
+}
+
+//-----stream generation
+
+static unsigned char *make_stream(const struct bench_opts *o, int *npackets){
+  unsigned char *buf;
+  int run,parity,i;
+  buf=(unsigned char *)malloc(o->packets*188);
+  if(buf==NULL) return NULL;
+  // packets of one parity in a row
+  run=(int)(o->rate*1000000./(188*8)/(o->flips>0?o->flips:1e-9));
+  if(run<1) run=1;
+  srand(0x47);
+  parity=0;
+  for(i=0;i<o->packets;i++){
+    unsigned char *pkt=buf+188*i;
+    int j;
+    for(j=4;j<188;j++) pkt[j]=rand();
+    if(i>0&&i%run==0) parity^=1;
+    pkt[0]=0x47;
+    pkt[1]=0x01;
+    pkt[2]=0x00;
+    pkt[3]=0x10|(i&0x0f);
+    if(rand()%100<o->scrambled) pkt[3]|=parity?0xc0:0x80;
+    if(rand()%100<o->adaptation){
+      pkt[3]|=0x20;
+      pkt[4]=rand()%(o->max_af+1);
+    }
+  }
+  *npackets=o->packets;
+  return buf;
+}
+
+static unsigned char *load_stream(const char *name, int *npackets){
+  FILE *f;
+  long size,i;
+  unsigned char *raw,*buf;
+  int n;
+  f=fopen(name,"rb");
+  if(f==NULL) return NULL;
+  fseek(f,0,SEEK_END);
+  size=ftell(f);
+  fseek(f,0,SEEK_SET);
+  raw=(unsigned char *)malloc(size>0?size:1);
+  buf=(unsigned char *)malloc(size>0?size:1);
+  if(raw==NULL||buf==NULL||fread(raw,1,size,f)!=(size_t)size){
+    fclose(f);
+    free(raw);
+    free(buf);
+    return NULL;
+  }
+  fclose(f);
+  // keep only packets that are in sync with the next one
+  n=0;
+  for(i=0;i+188<=size;){
+    if(raw[i]==0x47&&(i+188==size||raw[i+188]==0x47)){
+      memcpy(buf+188*n,raw+i,188);
+      n++;
+      i+=188;
+    }
+    else{
+      i++;
+    }
+  }
+  free(raw);
+  *npackets=n;
+  return buf;
+}
+
+//-----measure
+
+static void bench_engine(const struct ffdecsa_engine *e, const struct bench_opts *o,
+                         const unsigned char *stream, unsigned char *work, int npackets){
+  static const unsigned char ev[8]={0x11,0x22,0x33,0x66,0x44,0x55,0x66,0xff};
+  static const unsigned char od[8]={0x12,0x23,0x34,0x69,0x45,0x56,0x67,0x02};
+  unsigned char *cluster[3];
+  unsigned char *end=work+188*npackets;
+  unsigned char *p;
+  void *keys;
+  double elapsed=0.;
+  unsigned long long tsc=0;
+  long long packets=0,calls=0,handled=0;
+  int cs=o->cluster;
+
+  if(cs<=0){
+    // as get_suggested_cluster_size, for this engine
+    cs=e->parallelism+e->parallelism/10;
+    if(cs<e->parallelism+5) cs=e->parallelism+5;
+  }
+  keys=e->get_key_struct();
+  if(keys==NULL){
+    printf("%-12s out of memory\n",e->name);
+    return;
+  }
+  e->set_even_control_word(keys,ev);
+  e->set_odd_control_word(keys,od);
+
+  while(elapsed<o->seconds){
+    double t0;
+    unsigned long long c0;
+    memcpy(work,stream,188*npackets); // decryption is in place
+    t0=now();
+    c0=ticks();
+    for(p=work;p<end;p+=188*cs){
+      cluster[0]=p;
+      cluster[1]=(end-p>188*cs)?p+188*cs:end;
+      cluster[2]=NULL;
+      while(cluster[0]!=NULL){
+        handled+=e->decrypt_packets(keys,cluster);
+        calls++;
+      }
+    }
+    tsc+=ticks()-c0;
+    elapsed+=now()-t0;
+    packets+=npackets;
+  }
+  e->free_key_struct(keys);
+
+  printf("%-12s %4d %5d %9.1f %11.0f %6.1f",
+         e->name,e->parallelism,cs,
+         packets*188.*8./elapsed/1000000.,
+         packets/elapsed,
+         handled*100./((double)calls*e->parallelism));
+#ifdef FFDECSA_X86
+  printf(" %8.1f",(double)tsc/packets);
+#else
+  printf(" %8s","-");
+#endif
+  printf("%s\n",e==ffdecsa_selected_engine()?"  *":"");
+}
+
+int main(int argc, char **argv){
+  struct bench_opts o;
+  const struct ffdecsa_engine *const *e;
+  unsigned char *stream,*work;
+  int npackets,c;
+
+  o.packets=50000;
+  o.cluster=0;
+  o.scrambled=90;
+  o.adaptation=10;
+  o.max_af=183;
+  o.flips=0.1;
+  o.rate=40.;
+  o.seconds=2.;
+  o.engine=NULL;
+  o.file=NULL;
+  while((c=getopt(argc,argv,"p:c:s:a:A:f:r:t:e:i:h"))!=-1){
+    switch(c){
+      case 'p': o.packets=atoi(optarg); break;
+      case 'c': o.cluster=atoi(optarg); break;
+      case 's': o.scrambled=atoi(optarg); break;
+      case 'a': o.adaptation=atoi(optarg); break;
+      case 'A': o.max_af=atoi(optarg); break;
+      case 'f': o.flips=atof(optarg); break;
+      case 'r': o.rate=atof(optarg); break;
+      case 't': o.seconds=atof(optarg); break;
+      case 'e': o.engine=optarg; break;
+      case 'i': o.file=optarg; break;
+      default: usage(argv[0]); return 1;
+    }
+  }
+  if(o.packets<1||o.max_af<0||o.max_af>183){
+    usage(argv[0]);
+    return 1;
+  }
+
+  if(o.file!=NULL){
+    stream=load_stream(o.file,&npackets);
+    if(stream==NULL||npackets==0){
+      fprintf(stderr,"%s: no ts packets\n",o.file);
+      return 1;
+    }
+    printf("%s: %d packets\n",o.file,npackets);
+  }
+  else{
+    stream=make_stream(&o,&npackets);
+    if(stream==NULL){
+      fprintf(stderr,"out of memory\n");
+      return 1;
+    }
+    printf("synthetic: %d packets, %d%% scrambled, %d%% with adaptation field up to %d, %.3g parity flips/s at %.3g Mbps\n",
+           npackets,o.scrambled,o.adaptation,o.max_af,o.flips,o.rate);
+  }
+  work=(unsigned char *)malloc(188*npackets);
+  if(work==NULL){
+    fprintf(stderr,"out of memory\n");
+    return 1;
+  }
+
+  printf("%-12s %4s %5s %9s %11s %6s %8s\n","engine","par","clus","Mbps","pkt/s","eff%","cyc/pkt");
+  for(e=ffdecsa_engines();*e!=NULL;e++){
+    if(o.engine!=NULL&&strstr((*e)->name,o.engine)==NULL) continue;
+    if(!ffdecsa_engine_usable(*e)){
+      printf("%-12s not usable on this cpu\n",(*e)->name);
+      continue;
+    }
+    bench_engine(*e,&o,stream,work,npackets);
+  }
+
+  free(stream);
+  free(work);
+  return 0;
+}
@@ -0,0 +1,95 @@
+/* FFdecsa -- fast decsa algorithm
+ *
+ * Copyright (C) 2003-2004  fatih89r
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#ifndef FFDECSA_ENGINE_H
+#define FFDECSA_ENGINE_H
+
+//----- internal interface between the dispatcher (FFdecsa.cc) and the
+//----- bitslice engines (engine_*.cc, each one is FFdecsa_core.c built
+//----- with a different PARALLEL_MODE)
+
+//// parallelization stuff, large speed differences are possible
+// possible choices
+#define PARALLEL_32_4CHAR     320
+#define PARALLEL_32_4CHARA    321
+#define PARALLEL_32_INT       322
+#define PARALLEL_64_8CHAR     640
+#define PARALLEL_64_8CHARA    641
+#define PARALLEL_64_2INT      642
+#define PARALLEL_64_LONG      643
+#define PARALLEL_64_MMX       644
+#define PARALLEL_128_16CHAR  1280
+#define PARALLEL_128_16CHARA 1281
+#define PARALLEL_128_4INT    1282
+#define PARALLEL_128_2LONG   1283
+#define PARALLEL_128_2MMX    1284
+#define PARALLEL_128_SSE     1285
+#define PARALLEL_128_SSE2    1286
+
+// cpu features an engine needs, as reported by cpuid
+#define FFDECSA_CPU_MMX      0x01
+#define FFDECSA_CPU_SSE      0x02
+#define FFDECSA_CPU_SSE2     0x04
+
+#if defined(__i386__) || defined(__x86_64__)
+#define FFDECSA_X86
+#endif
+
+struct ffdecsa_engine{
+  const char *name;
+  int mode;          // PARALLEL_xxx
+  int parallelism;   // GROUP_PARALLELISM
+  unsigned int cpu;  // FFDECSA_CPU_xxx bits required to run it
+  void *(*get_key_struct)(void);
+  void (*free_key_struct)(void *keys);
+  void (*set_even_control_word)(void *keys, const unsigned char *even);
+  void (*set_odd_control_word)(void *keys, const unsigned char *odd);
+  void (*get_control_words)(void *keys, unsigned char *even, unsigned char *odd);
+  int (*decrypt_packets)(void *keys, unsigned char **cluster);
+  int (*decrypt_packets_multi)(void **keys, unsigned char **cluster, int *cluster_keys);
+};
+
+extern const struct ffdecsa_engine ffdecsa_engine_032_4char;
+extern const struct ffdecsa_engine ffdecsa_engine_032_4charA;
+extern const struct ffdecsa_engine ffdecsa_engine_032_int;
+extern const struct ffdecsa_engine ffdecsa_engine_064_8char;
+extern const struct ffdecsa_engine ffdecsa_engine_064_8charA;
+extern const struct ffdecsa_engine ffdecsa_engine_064_2int;
+extern const struct ffdecsa_engine ffdecsa_engine_064_long;
+extern const struct ffdecsa_engine ffdecsa_engine_128_16char;
+extern const struct ffdecsa_engine ffdecsa_engine_128_16charA;
+extern const struct ffdecsa_engine ffdecsa_engine_128_4int;
+extern const struct ffdecsa_engine ffdecsa_engine_128_2long;
+#ifdef FFDECSA_X86
+extern const struct ffdecsa_engine ffdecsa_engine_064_mmx;
+extern const struct ffdecsa_engine ffdecsa_engine_128_2mmx;
+extern const struct ffdecsa_engine ffdecsa_engine_128_sse;
+extern const struct ffdecsa_engine ffdecsa_engine_128_sse2;
+#endif
+
+// for tools like FFdecsa_bench.cc, implemented by the dispatcher
+// every engine built in, NULL terminated
+const struct ffdecsa_engine *const *ffdecsa_engines(void);
+// the cpu can run it and it decrypts like PARALLEL_32_INT
+int ffdecsa_engine_usable(const struct ffdecsa_engine *e);
+// the one behind the public interface
+const struct ffdecsa_engine *ffdecsa_selected_engine(void);
+
+#endif
@@ -0,0 +1,27 @@
+/* FFdecsa -- fast decsa algorithm
+ *
+ * Copyright (C) 2003-2004  fatih89r
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "FFdecsa_engine.h"
+
+#define PARALLEL_MODE       PARALLEL_64_2INT
+#define FFDECSA_ENGINE      ffdecsa_engine_064_2int
+#define FFDECSA_ENGINE_NAME "64_2INT"
+#define FFDECSA_ENGINE_CPU  (0)
+
+#include "FFdecsa_core.c"
@@ -20,6 +20,8 @@
 
 #include <emmintrin.h>
 
+// every buffer accessed as group or batch must be 16 byte aligned,
+// movdqa faults otherwise (i386 only aligns the stack, not char arrays)
 #define MEMALIGN __attribute__((aligned(16)))
 
 union __u128i {
@@ -65,7 +67,7 @@ typedef __m128i batch;
 #define B_FFSH8L(a,n) _mm_slli_epi64((a),(n))
 #define B_FFSH8R(a,n) _mm_srli_epi64((a),(n))
 
-#define M_EMPTY()
+#define M_EMPTY()    // no mmx registers used, nothing to restore
 
 #undef BEST_SPAN
 #define BEST_SPAN            16
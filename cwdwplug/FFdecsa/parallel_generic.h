@@ -80,17 +80,22 @@
                            }while(0)
 
 #else
-#define XOR_4_BY(d,s1,s2)    do{ int *pd=(int *)(d), *ps1=(int *)(s1), *ps2=(int *)(s2); \
+// packet bytes, ib, block_out etc. are written as one type and read back
+// as another; may_alias keeps the optimizer from reordering those accesses
+// (gcc -O3 slp vectorization broke PARALLEL_32_INT without it)
+typedef int       ffdecsa_u4by __attribute__((may_alias));
+typedef long long ffdecsa_u8by __attribute__((may_alias));
+#define XOR_4_BY(d,s1,s2)    do{ ffdecsa_u4by *pd=(ffdecsa_u4by *)(d), *ps1=(ffdecsa_u4by *)(s1), *ps2=(ffdecsa_u4by *)(s2); \
                                *pd = *ps1  ^ *ps2; }while(0)
-#define XOR_8_BY(d,s1,s2)    do{ long long int *pd=(long long int *)(d), *ps1=(long long int *)(s1), *ps2=(long long int *)(s2); \
+#define XOR_8_BY(d,s1,s2)    do{ ffdecsa_u8by *pd=(ffdecsa_u8by *)(d), *ps1=(ffdecsa_u8by *)(s1), *ps2=(ffdecsa_u8by *)(s2); \
                                *pd = *ps1  ^ *ps2; }while(0)
-#define XOREQ_4_BY(d,s)      do{ int *pd=(int *)(d), *ps=(int *)(s); \
+#define XOREQ_4_BY(d,s)      do{ ffdecsa_u4by *pd=(ffdecsa_u4by *)(d), *ps=(ffdecsa_u4by *)(s); \
                                *pd ^= *ps; }while(0)
-#define XOREQ_8_BY(d,s)      do{ long long int *pd=(long long int *)(d), *ps=(long long int *)(s); \
+#define XOREQ_8_BY(d,s)      do{ ffdecsa_u8by *pd=(ffdecsa_u8by *)(d), *ps=(ffdecsa_u8by *)(s); \
                                *pd ^= *ps; }while(0)
-#define COPY_4_BY(d,s)       do{ int *pd=(int *)(d), *ps=(int *)(s); \
+#define COPY_4_BY(d,s)       do{ ffdecsa_u4by *pd=(ffdecsa_u4by *)(d), *ps=(ffdecsa_u4by *)(s); \
                                *pd = *ps; }while(0)
-#define COPY_8_BY(d,s)       do{ long long int *pd=(long long int *)(d), *ps=(long long int *)(s); \
+#define COPY_8_BY(d,s)       do{ ffdecsa_u8by *pd=(ffdecsa_u8by *)(d), *ps=(ffdecsa_u8by *)(s); \
                                *pd = *ps; }while(0)
 
 #define BEST_SPAN            8
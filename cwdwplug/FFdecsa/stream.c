@@ -432,18 +432,32 @@ static inline void trasp64_128_88cw(unsigned char *data){
   }
 #undef halfrow
 }
+
+// 8 bytes per packet (FFTABLEIN layout) to 64 groups, group 8*byte+bit
+// holding that bit of every packet
+static inline void trasp64_88ccw(unsigned char *data){
+#if GROUP_PARALLELISM==32
+trasp64_32_88ccw(data);
+#endif
+#if GROUP_PARALLELISM==64
+trasp64_64_88ccw(data);
+#endif
+#if GROUP_PARALLELISM==128
+trasp64_128_88ccw(data);
+#endif
+}
 #endif
 
 
 #ifdef STREAM_INIT
-void stream_cypher_group_init(
+static void stream_cypher_group_init(
   struct stream_regs *regs,
   group         iA[8][4], // [In]  iA00,iA01,...iA73 32 groups  | Derived from key.
   group         iB[8][4], // [In]  iB00,iB01,...iB73 32 groups  | Derived from key.
   unsigned char *sb)      // [In]  (SB0,SB1,...SB7)...x32 32*8 bytes | Extra input.
 #endif
 #ifdef STREAM_NORMAL
-void stream_cypher_group_normal(
+static void stream_cypher_group_normal(
   struct stream_regs *regs,
   unsigned char *cb)    // [Out] (CB0,CB1,...CB7)...x32 32*8 bytes | Output.
 #endif
@@ -480,15 +494,7 @@ for(j=0;j<64;j++){
 }
 
 DBG(dump_mem("stream_prerot ",sb,GROUP_PARALLELISM*8,BYPG));
-#if GROUP_PARALLELISM==32
-trasp64_32_88ccw(sb);
-#endif
-#if GROUP_PARALLELISM==64
-trasp64_64_88ccw(sb);
-#endif
-#if GROUP_PARALLELISM==128
-trasp64_128_88ccw(sb);
-#endif
+trasp64_88ccw(sb);
 DBG(dump_mem("stream_postrot",sb,GROUP_PARALLELISM*8,BYPG));
 
 for(j=0;j<64;j++){
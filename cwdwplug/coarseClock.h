@@ -0,0 +1,45 @@
+#if !defined(__COARSECLOCK_H__)
+#define __COARSECLOCK_H__
+
+/* Coarse monotonic clock for the plugin.
+ *
+ * coarseTick counts milliseconds of a monotonic clock, so it doesn't jump
+ * with the wall clock. It is brought up to date by coarseClockUpdate, which
+ * the controllers' run loops call every COARSE_CLOCK_PERIOD seconds and
+ * which anyone else may call for a fresh value; readers just load it. It
+ * wraps after 49 days, compare ticks with coarseTickReached only. */
+
+#include <stdint.h>
+#if defined(__APPLE__)
+#include <mach/mach_time.h>
+#else
+#include <time.h>
+#endif
+
+#define COARSE_CLOCK_PERIOD  0.1   // seconds
+
+extern volatile uint32_t coarseTick;
+
+static inline uint32_t coarseClockUpdate(void)
+{
+#if defined(__APPLE__)
+  static mach_timebase_info_data_t timebase;
+  if( timebase.denom == 0 )
+    mach_timebase_info(&timebase);
+  uint64_t ms = mach_absolute_time() * timebase.numer / timebase.denom / 1000000;
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  uint64_t ms = (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+#endif
+  coarseTick = (uint32_t)ms;
+  return (uint32_t)ms;
+}
+
+// the tick is at or past the deadline
+static inline bool coarseTickReached(uint32_t tick, uint32_t deadline)
+{
+  return (int32_t)(tick - deadline) >= 0;
+}
+
+#endif
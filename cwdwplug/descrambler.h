@@ -0,0 +1,34 @@
+#if !defined(__DESCRAMBLER_H__)
+#define __DESCRAMBLER_H__
+
+/* Descrambler worker, one thread per device.
+ *
+ * EyeTV owns the packets it hands to the plugin only for the duration of
+ * the callback and takes them back in stream order, so nothing can be left
+ * for later. The worker shares the callback's decryption instead: the
+ * callback posts the second half of its scrambled packets to the worker,
+ * decrypts the first half itself and then waits for the worker's half.
+ * Both halves are decrypted in place, on two cores at once.
+ *
+ * The callback doesn't wait for a worker that hasn't started: when its own
+ * half is done and the worker's is still untouched, it takes that half back
+ * and decrypts it too. A callback so takes about as long as without a
+ * worker at worst. Packets that don't fill two of the engine's clusters
+ * aren't split. */
+
+#include <stdint.h>
+#include "statistics.h"
+
+typedef struct descrambler descrambler;
+
+// nkeys key structures as from get_key_struct, cluster as get_internal_parallelism
+descrambler *descramblerNew(void **keys, int nkeys, int cluster);
+void descramblerFree(descrambler *d);
+/* Packet thread only: decrypts packet i with keys[keyIndex[i]], in place,
+ * before it returns. What the packet thread decrypts itself is counted in
+ * mine. */
+void descramblerDecrypt(descrambler *d, unsigned char **pkts, const int *keyIndex, int count, decryptCounters *mine);
+// any thread: adds the worker's decrypt counters
+void descramblerStatistics(descrambler *d, deviceStatistics *s);
+
+#endif
@@ -0,0 +1,150 @@
+#include "descrambler.h"
+#include "cwslot.h"
+#include "FFdecsa/FFdecsa.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+// the worker's share, moved on with lock held
+enum
+{
+  SHARE_NONE,     // nothing posted
+  SHARE_POSTED,   // posted, the callback may still take it back
+  SHARE_TAKEN     // the worker decrypts it, the callback waits
+};
+
+struct descrambler
+{
+  void **keys;
+  int nkeys;
+  int cluster;
+
+  // the worker's share of the callback's packets
+  unsigned char **pkts;
+  const int *keyIndex;
+  int count;
+  int state;
+
+  decryptCounters counters;   // the worker's
+
+  pthread_t thread;
+  pthread_mutex_t lock;
+  pthread_cond_t posted;
+  pthread_cond_t finished;
+  bool stop;
+};
+
+static void decrypt(descrambler *d, unsigned char **pkts, const int *keyIndex, int count, decryptCounters *c)
+{
+  uint64_t start = cwSlotNow();
+  decrypt_packets_iov_multi(d->keys, d->nkeys, pkts, keyIndex, count);
+  decryptCountersAdd(c, count, d->cluster, cwSlotNow() - start);
+}
+
+static void *workerMain(void *arg)
+{
+  descrambler *d = (descrambler *)arg;
+
+  pthread_mutex_lock(&d->lock);
+  while( d->stop == false )
+  {
+    if( d->state != SHARE_POSTED )
+    {
+      pthread_cond_wait(&d->posted, &d->lock);
+      continue;
+    }
+    d->state = SHARE_TAKEN;
+    pthread_mutex_unlock(&d->lock);
+    decrypt(d, d->pkts, d->keyIndex, d->count, &d->counters);
+    pthread_mutex_lock(&d->lock);
+    d->state = SHARE_NONE;
+    pthread_cond_signal(&d->finished);
+  }
+  pthread_mutex_unlock(&d->lock);
+  return NULL;
+}
+
+descrambler *descramblerNew(void **keys, int nkeys, int cluster)
+{
+  if( nkeys < 1 || nkeys > MAX_KEYS )
+    return NULL;
+  descrambler *d = (descrambler *)calloc(1, sizeof(descrambler));
+  if( d == NULL )
+    return NULL;
+  d->keys = (void **)malloc(nkeys * sizeof(void *));
+  if( d->keys == NULL )
+  {
+    free(d);
+    return NULL;
+  }
+  memcpy(d->keys, keys, nkeys * sizeof(void *));
+  d->nkeys = nkeys;
+  d->cluster = cluster > 0 ? cluster : 1;
+  d->state = SHARE_NONE;
+  pthread_mutex_init(&d->lock, NULL);
+  pthread_cond_init(&d->posted, NULL);
+  pthread_cond_init(&d->finished, NULL);
+  if( pthread_create(&d->thread, NULL, workerMain, d) != 0 )
+  {
+    pthread_cond_destroy(&d->finished);
+    pthread_cond_destroy(&d->posted);
+    pthread_mutex_destroy(&d->lock);
+    free(d->keys);
+    free(d);
+    return NULL;
+  }
+  return d;
+}
+
+void descramblerFree(descrambler *d)
+{
+  if( d == NULL )
+    return;
+  pthread_mutex_lock(&d->lock);
+  d->stop = true;
+  pthread_cond_signal(&d->posted);
+  pthread_mutex_unlock(&d->lock);
+  pthread_join(d->thread, NULL);
+  pthread_cond_destroy(&d->finished);
+  pthread_cond_destroy(&d->posted);
+  pthread_mutex_destroy(&d->lock);
+  free(d->keys);
+  free(d);
+}
+
+void descramblerDecrypt(descrambler *d, unsigned char **pkts, const int *keyIndex, int count, decryptCounters *mine)
+{
+  if( count < 2 * d->cluster )
+  {
+    decrypt(d, pkts, keyIndex, count, mine);
+    return;
+  }
+  // the callback's half in whole clusters, the rest for the worker
+  int own = count / 2 / d->cluster * d->cluster;
+  pthread_mutex_lock(&d->lock);
+  d->pkts = pkts + own;
+  d->keyIndex = keyIndex + own;
+  d->count = count - own;
+  d->state = SHARE_POSTED;
+  pthread_cond_signal(&d->posted);
+  pthread_mutex_unlock(&d->lock);
+
+  decrypt(d, pkts, keyIndex, own, mine);
+
+  pthread_mutex_lock(&d->lock);
+  bool takeBack = d->state == SHARE_POSTED;
+  if( takeBack == true )
+    d->state = SHARE_NONE;
+  while( d->state == SHARE_TAKEN )
+    pthread_cond_wait(&d->finished, &d->lock);
+  pthread_mutex_unlock(&d->lock);
+  if( takeBack == true )
+    decrypt(d, pkts + own, keyIndex + own, count - own, mine);
+}
+
+void descramblerStatistics(descrambler *d, deviceStatistics *s)
+{
+  uint64_t before = s->decrypted;
+  decryptCountersRead(&d->counters, s);
+  s->offloaded += s->decrypted - before;
+}
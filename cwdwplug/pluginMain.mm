@@ -28,19 +28,6 @@
 
 #define PLUGIN_NOTIFICATION_OBJECT	"cwdwgw"
 
-#pragma push
-#pragma pack(1)
-
-
-/* Structure for TS-Packets */
-typedef struct 
-{
-  unsigned char header[4];
-  unsigned char	data[188-4];
-} TransportStreamPacket;
-
-#pragma pop
-
 VLCEyeTVPluginGlobals_t *lGlobals = 0;
 
 //static Controller *ctrl = 0;
@@ -202,44 +189,75 @@ static long VLCEyeTVPluginPacketsArrived(VLCEyeTVPluginGlobals_t *globals, EyeTV
       if( deviceInfo != 0 && ctrls[devIndex] != 0 ) 
       {
 	bool needSendPids = NO;
-	for(int i = 0; i < packetsCount; i++ ) 
+	[ctrls[devIndex] pollControlWords];
+	[ctrls[devIndex] countPackets:packetsCount];
+	// scrambled packets of all services are collected and decrypted in
+	// one pass per batch, each with the keys of its service
+	unsigned int descramble = [ctrls[devIndex] descrambleMask];
+	// read without locks, see Controller's -pidFlags
+	const volatile unsigned char *pidFlags = [ctrls[devIndex] pidFlags];
+	const volatile unsigned char *pidContext = [ctrls[devIndex] pidContexts];
+	unsigned char *scrambled[TS_BATCH_MAX];
+	int scrambledKeys[TS_BATCH_MAX];
+	tsBatch batch;
+	for(int base = 0; base < packetsCount; base += TS_BATCH_MAX )
 	{
-	  TransportStreamPacket *packet = ( TransportStreamPacket* )packets[i];
-	  
-	  // search for PID 
-	  unsigned int PID = ((packet->header[1] & 0x1fL) << 8) | (packet->header[2] & 0xffL);
+	  unsigned char **pkts = (unsigned char **)&packets[base];
+	  tsClassify(&batch, pkts, packetsCount - base);
 	  
-	  if( [ctrls[devIndex] isPidInList:PID] == YES ) 
+	  // the PIDs for the daemon, each in its own order
+	  for(int g = 0; g < batch.pidCount; g++ )
 	  {
-	    NSArray *sndData = [NSArray arrayWithObjects:[NSData dataWithBytes:&packet->header[0] length:188], [NSNumber numberWithInt:devIndex], nil];
-	    [ctrls[devIndex] sendData:[NSArray arrayWithObjects:sndData, nil]];
-	    globals->packetCount++;
-	    needSendPids = YES;
-	  }
-	  
-	  if( doSendTsPackets == YES && (PID == 0 || PID == 0x11 || PID == 0x12) )
-	  {
-	    NSArray *sndData = [NSArray arrayWithObjects:[NSData dataWithBytes:&packet->header[0] length:188], [NSNumber numberWithInt:devIndex], nil];
-	    [ctrls[devIndex] sendData:[NSArray arrayWithObjects:sndData, nil]];
+	    unsigned int PID = batch.pid[g];
+	    unsigned char flags = pidFlags[PID];
+	    bool sendTs = doSendTsPackets == YES && (PID == 0 || PID == 0x11 || PID == 0x12);
+	    if( (flags & PID_FLAG_SEND) == 0 && sendTs == false )
+	      continue;
+	    for(int k = batch.first[g]; k < batch.first[g + 1]; k++ )
+	    {
+	      int i = batch.index[k];
+	      if( flags & PID_FLAG_SEND ) 
+	      {
+		[ctrls[devIndex] sendSectionPacket:pkts[i] info:&batch.info[i]];
+		globals->packetCount++;
+	      }
+	      if( sendTs == true )
+	      {
+		[ctrls[devIndex] sendPacket:pkts[i] length:188];
+	      }
+	    }
 	    needSendPids = YES;
 	  }
 	  
-	  if( [ctrls[devIndex] descramble] == YES )
+	  // the scrambled ones in stream order
+	  int scrambledCount = 0;
+	  if( descramble != 0 )
 	  {
-	    if( [ctrls[devIndex] isPidInDescramblerList:PID] == YES )
+	    for(int i = 0; i < batch.count; i++ )
 	    {
-	      [ctrls[devIndex] appendTsPacket:&packet->header[0] length:188];
-	      [ctrls[devIndex] getCleanTsPacket:&packet->header[0]];
-	    // DEBUG
-	      if( doSendTsPackets == YES )
+	      const tsPacketInfo *info = &batch.info[i];
+	      if( info->scrambling != 0 && (pidFlags[info->pid] & PID_FLAG_DESCRAMBLE) )
 	      {
-		NSArray *sndData = [NSArray arrayWithObjects:[NSData dataWithBytes:&packet->header[0] length:188], [NSNumber numberWithInt:devIndex], nil];
-		[ctrls[devIndex] sendData:[NSArray arrayWithObjects:sndData, nil]];
-		needSendPids = YES;
+		int ctx = pidContext[info->pid];
+		if( descramble & (1 << ctx) )
+		{
+		  scrambledKeys[scrambledCount] = ctx;
+		  scrambled[scrambledCount++] = pkts[i];
+		}
 	      }
-	    // DEBUG  
 	    }
 	  }
+	  [ctrls[devIndex] descramblePackets:scrambled keys:scrambledKeys count:scrambledCount];
+	  // DEBUG
+	  if( doSendTsPackets == YES )
+	  {
+	    for(int i = 0; i < scrambledCount; i++ )
+	    {
+	      [ctrls[devIndex] sendPacket:scrambled[i] length:188];
+	      needSendPids = YES;
+	    }
+	  }
+	  // DEBUG  
 	}
       }
     }
@@ -297,12 +315,22 @@ static long VLCEyeTVPluginServiceChanged(VLCEyeTVPluginGlobals_t *globals,
 		  }
 		}
 		
-	if( (deviceInfo->headendID != headendID) || (deviceInfo->transponderID != transponderID)  || (deviceInfo->serviceID != serviceID) || pidsChanged )
+	bool retuned = (deviceInfo->headendID != headendID) || (deviceInfo->transponderID != transponderID);
+	if( retuned || (deviceInfo->serviceID != serviceID) || pidsChanged )
 	{
 	  [ctrls[devIndex] clearPidList];
-	  [ctrls[devIndex] setDescramble:NO];
-	  [ctrls[devIndex] clearDescramblerPidList];
-	  [ctrls[devIndex] channelChange];
+	  if( retuned )
+	  {
+	    [ctrls[devIndex] clearKeyContexts];
+	    [ctrls[devIndex] channelChange];
+	  }
+	  else
+	  {
+	    // the services tuned before on the transponder keep their PIDs and
+	    // control words, while they last
+	    [ctrls[devIndex] resetSections];
+	  }
+	  int ctx = [ctrls[devIndex] keyContextForService:serviceID];
 	  pluginLog("ServiceChanged:\n");
 	  deviceInfo->headendID = headendID;
 	  deviceInfo->transponderID = transponderID;
@@ -320,15 +348,14 @@ static long VLCEyeTVPluginServiceChanged(VLCEyeTVPluginGlobals_t *globals,
 		pidList[i].pidType == kEyeTVPIDType_MPEGAudio ||
 		pidList[i].pidType == 0xd )
 	    {
-	      [ctrls[devIndex] addPidToDescrambler:pidList[i].pid];
+	      [ctrls[devIndex] addPidToDescrambler:pidList[i].pid context:ctx];
 	    }
 	  }
 
 	  msgNewChannel message;
 	  fillNewChannelMessage(&message,transponderID,serviceID,pmtpid);
 	  pluginLog("HeadendID: %lx, TransponderID: %lx, ServiceID: %lx, PMT pid: %lx\n" , headendID, transponderID, serviceID, pmtpid);
-	  NSArray *ncMsg = [NSArray arrayWithObjects:[NSData dataWithBytes:&message length:sizeof(message)], [NSNumber numberWithInt:devIndex], nil];
-	  [ctrls[devIndex] sendData:[NSArray arrayWithObjects:ncMsg, nil]];
+	  [ctrls[devIndex] sendPacket:(const unsigned char *)&message length:sizeof(message)];
 	}      
 	deviceInfo->pidsCount = 0;
 	
@@ -0,0 +1,52 @@
+#if !defined(__SECTIONGATE_H__)
+#define __SECTIONGATE_H__
+
+/* Section gate for the PIDs forwarded to the daemon (PMT, CAT, ECM, EMM).
+ *
+ * The packets of a PID are held back until they make up a complete unit, as
+ * the daemon's section filter assembles it: from a packet with the
+ * payload_unit_start_indicator set up to the end of its first section, plus
+ * the sections that follow it within the same packets. A section may end in
+ * the bytes the pointer_field of the next unit start skips, that packet then
+ * goes out with the unit too. A complete unit is handed out as it arrived,
+ * raw TS packets, so the daemon's section code doesn't change. Units it would
+ * throw away (broken continuity, stuffing) are dropped here, and so are units
+ * whose sections were already forwarded lately for the same PID: identical
+ * CRC, table, version and section number for sections with a CRC, identical
+ * bytes for the others (ECM, EMM). A repeat still goes out once every
+ * SECTION_GATE_REFRESH seconds, so the daemon can retry a request that
+ * failed. */
+
+#include <stdint.h>
+#include <time.h>
+#include "tsbatch.h"
+
+#define SECTION_GATE_PACKETS  24   // a 4096 byte section and the packet it starts in
+#define SECTION_GATE_HISTORY  16   // units remembered per PID
+#define SECTION_GATE_REFRESH  5    // seconds
+
+typedef struct
+{
+  unsigned char packets[SECTION_GATE_PACKETS][188];
+  unsigned char payload[SECTION_GATE_PACKETS * 184];
+  unsigned char sent[SECTION_GATE_PACKETS + 1][188];  // the unit handed out last
+  int packetCount;      // packets of the unit so far, 0 = waiting for a start
+  int payloadLen;
+  int cc;               // continuity counter of the last packet
+  uint32_t history[SECTION_GATE_HISTORY];
+  time_t forwarded[SECTION_GATE_HISTORY];
+  int historyCount;
+  int historyNext;
+} sectionGate;
+
+sectionGate *sectionGateNew(void);
+void sectionGateFree(sectionGate *g);
+// forget the unit in progress and the sections forwarded
+void sectionGateReset(sectionGate *g);
+/* Feeds one TS packet of the gate's PID, info as tsClassify found it.
+ * Returns the number of packets to forward, 188 bytes each from *out, or 0
+ * while a unit is incomplete or when it was dropped. *out stays valid up to
+ * the next call. */
+int sectionGatePacket(sectionGate *g, const unsigned char *pkt, const tsPacketInfo *info, const unsigned char **out);
+
+#endif
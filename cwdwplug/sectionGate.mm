@@ -0,0 +1,171 @@
+#include "sectionGate.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define FNV_OFFSET  2166136261u
+#define FNV_PRIME   16777619u
+
+static inline uint32_t fnv1a(uint32_t h, const unsigned char *p, int len)
+{
+  for(int i = 0; i < len; i++)
+  {
+    h ^= p[i];
+    h *= FNV_PRIME;
+  }
+  return h;
+}
+
+/* Identifies the sections of a complete unit, walked as the daemon's
+ * nextSection does. A section with a CRC is known by its CRC, table id,
+ * extension, version and number; the others by their bytes. */
+static uint32_t unitDigest(const unsigned char *p, int len)
+{
+  uint32_t h = FNV_OFFSET;
+  int offset = 0;
+  while( offset + 3 <= len && p[offset] != 0xff )
+  {
+    const unsigned char *s = p + offset;
+    int sectionLen = (((s[1] & 0xf) << 8) | s[2]) + 3;
+    if( offset + sectionLen > len )
+      break;
+    if( (s[1] & 0x80) && sectionLen >= 12 )
+    {
+      unsigned char id[9] = { s[0], s[3], s[4], s[5], s[6],
+			      s[sectionLen - 4], s[sectionLen - 3], s[sectionLen - 2], s[sectionLen - 1] };
+      h = fnv1a(h, id, sizeof(id));
+    }
+    else
+    {
+      h = fnv1a(h, s, sectionLen);
+    }
+    offset += sectionLen;
+  }
+  return h;
+}
+
+// true when the unit is new or its last forward is old enough to repeat it
+static bool remember(sectionGate *g, uint32_t digest)
+{
+  time_t now = time(NULL);
+  for(int i = 0; i < g->historyCount; i++)
+  {
+    if( g->history[i] == digest )
+    {
+      if( now - g->forwarded[i] < SECTION_GATE_REFRESH && now >= g->forwarded[i] )
+	return false;
+      g->forwarded[i] = now;
+      return true;
+    }
+  }
+  g->history[g->historyNext] = digest;
+  g->forwarded[g->historyNext] = now;
+  g->historyNext = (g->historyNext + 1) % SECTION_GATE_HISTORY;
+  if( g->historyCount < SECTION_GATE_HISTORY )
+    g->historyCount++;
+  return true;
+}
+
+static inline void dropUnit(sectionGate *g)
+{
+  g->packetCount = 0;
+  g->payloadLen = 0;
+}
+
+sectionGate *sectionGateNew(void)
+{
+  sectionGate *g = (sectionGate *)malloc(sizeof(sectionGate));
+  if( g != NULL )
+    sectionGateReset(g);
+  return g;
+}
+
+void sectionGateFree(sectionGate *g)
+{
+  free(g);
+}
+
+void sectionGateReset(sectionGate *g)
+{
+  dropUnit(g);
+  g->cc = 0;
+  g->historyCount = 0;
+  g->historyNext = 0;
+}
+
+/* -1 while the first section of the unit is incomplete, 0 when the unit is
+ * dropped or was forwarded lately, 1 when it goes out */
+static int unitEnd(sectionGate *g)
+{
+  if( g->payloadLen < 3 )
+    return -1;
+  // stuffing only, the daemon would wait for it to end until the next start
+  if( g->payload[0] == 0xff )
+    return 0;
+  int sectionLen = (((g->payload[1] & 0xf) << 8) | g->payload[2]) + 3;
+  if( sectionLen > g->payloadLen )
+    return -1;
+  return remember(g, unitDigest(g->payload, g->payloadLen)) ? 1 : 0;
+}
+
+// true when the packet starts or continues the unit
+static bool addPacket(sectionGate *g, const unsigned char *pkt, const tsPacketInfo *info)
+{
+  int len = info->payloadLen;
+  if( g->packetCount == 0 )
+  {
+    if( (info->flags & TS_START) == 0 || len <= 0 )
+      return false;
+  }
+  else if( len <= 0 || info->continuity != ((g->cc + 1) & 0x0f) || g->packetCount == SECTION_GATE_PACKETS )
+  {
+    dropUnit(g);
+    return false;
+  }
+  memcpy(g->packets[g->packetCount++], pkt, 188);
+  memcpy(g->payload + g->payloadLen, pkt + info->payload, len);
+  g->payloadLen += len;
+  g->cc = info->continuity;
+  return true;
+}
+
+int sectionGatePacket(sectionGate *g, const unsigned char *pkt, const tsPacketInfo *info, const unsigned char **out)
+{
+  int count = 0;
+
+  *out = NULL;
+  if( g->packetCount > 0 && (info->flags & TS_START) )
+  {
+    /* the bytes the pointer_field skips end the unit in progress, the daemon
+     * appends them before it starts over. A unit ended here goes out with
+     * this packet. */
+    int raw = (info->flags & TS_ADAPTATION) ? 5 + pkt[4] : 4;
+    int tail = info->payload - raw - 1;
+    if( info->payloadLen > 0 && info->continuity == ((g->cc + 1) & 0x0f) && g->payloadLen + tail <= (int)sizeof(g->payload) )
+    {
+      memcpy(g->payload + g->payloadLen, pkt + raw + 1, tail);
+      g->payloadLen += tail;
+      if( unitEnd(g) > 0 )
+      {
+	count = g->packetCount;
+	memcpy(g->sent, g->packets, count * 188);
+	memcpy(g->sent[count++], pkt, 188);
+      }
+    }
+    dropUnit(g);
+  }
+  if( addPacket(g, pkt, info) )
+  {
+    int end = unitEnd(g);
+    // a unit ended in its start packet went out already if the one before did
+    if( end > 0 && count == 0 )
+    {
+      count = g->packetCount;
+      memcpy(g->sent, g->packets, count * 188);
+    }
+    if( end >= 0 )
+      dropUnit(g);
+  }
+  if( count > 0 )
+    *out = g->sent[0];
+  return count;
+}
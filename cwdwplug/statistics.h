@@ -0,0 +1,117 @@
+#if !defined(__STATISTICS_H__)
+#define __STATISTICS_H__
+
+/* Descrambler statistics of a device.
+ *
+ * The counters are always on. Each one has a single writer, the packet
+ * callback or the descrambler worker, which adds to it once per callback or
+ * per decrypt call, never per packet; readers take a snapshot with
+ * -[Controller statistics:] whenever they like. The callback and the worker
+ * keep decryptCounters of their own, the snapshot adds them up.
+ *
+ * A 64 bit counter takes two stores on i386, so the writer brackets its
+ * updates with a sequence counter, odd while they are under way, and a
+ * reader copies them again when it changed meanwhile. */
+
+#include <stdint.h>
+#include <sched.h>
+
+#define STATS_FILL_BINS  10   // tenths of the clusters' capacity
+
+// decrypt calls, kept by whoever decrypts
+typedef struct
+{
+  volatile uint32_t seq;          // see countersWriteBegin
+  volatile uint64_t decrypted;    // packets
+  volatile uint64_t calls;        // decrypt_packets_iov calls
+  volatile uint64_t usec;         // spent decrypting
+  volatile uint64_t fill[STATS_FILL_BINS];
+} decryptCounters;
+
+typedef struct
+{
+  uint64_t packets;               // seen by the packet callback
+  uint64_t scrambled;             // scrambled ones on descrambled PIDs
+  uint64_t decrypted;
+  uint64_t offloaded;             // decrypted by the worker
+  uint64_t calls;
+  /* Calls by how full the engine's clusters were: a call of n packets runs
+   * ceil(n / parallelism) clusters; bin i counts fills from i tenths up to
+   * i + 1 tenths, the last bin also completely full ones. */
+  uint64_t fill[STATS_FILL_BINS];
+  int parallelism;
+  uint64_t usec;                  // spent decrypting, all threads together
+  double decryptMbps;             // while decrypting, not over the wall clock
+  double cwAge;                   // seconds since the last control word
+  double parityAge;               // seconds since the last parity change, -1 if none yet
+} deviceStatistics;
+
+static inline void countersWriteBegin(volatile uint32_t *seq)
+{
+  *seq = *seq + 1;
+  __sync_synchronize();   // odd before the counters change
+}
+
+static inline void countersWriteEnd(volatile uint32_t *seq)
+{
+  __sync_synchronize();   // counters complete before it is even again
+  *seq = *seq + 1;
+}
+
+// a reader's start, waits out a writer under way
+static inline uint32_t countersReadBegin(const volatile uint32_t *seq)
+{
+  uint32_t s;
+  while( ((s = *seq) & 1) != 0 )
+    sched_yield();
+  __sync_synchronize();
+  return s;
+}
+
+// true when a writer came in between, the copy is to be made again
+static inline bool countersReadRetry(const volatile uint32_t *seq, uint32_t s)
+{
+  __sync_synchronize();
+  return *seq != s;
+}
+
+static inline void decryptCountersAdd(decryptCounters *c, int packets, int parallelism, uint64_t usec)
+{
+  if( packets <= 0 || parallelism <= 0 )
+    return;
+  int clusters = (packets + parallelism - 1) / parallelism;
+  int bin = packets * STATS_FILL_BINS / (clusters * parallelism);
+  if( bin >= STATS_FILL_BINS )
+    bin = STATS_FILL_BINS - 1;
+  countersWriteBegin(&c->seq);
+  c->decrypted += packets;
+  c->calls++;
+  c->usec += usec;
+  c->fill[bin]++;
+  countersWriteEnd(&c->seq);
+}
+
+// adds the counters to the snapshot
+static inline void decryptCountersRead(const decryptCounters *c, deviceStatistics *s)
+{
+  uint64_t decrypted, calls, usec, fill[STATS_FILL_BINS];
+  uint32_t seq;
+  do
+  {
+    seq = countersReadBegin(&c->seq);
+    decrypted = c->decrypted;
+    calls = c->calls;
+    usec = c->usec;
+    for(int i = 0; i < STATS_FILL_BINS; i++)
+      fill[i] = c->fill[i];
+  }
+  while( countersReadRetry(&c->seq, seq) );
+  s->decrypted += decrypted;
+  s->calls += calls;
+  s->usec += usec;
+  for(int i = 0; i < STATS_FILL_BINS; i++)
+    s->fill[i] += fill[i];
+  s->decryptMbps = s->usec > 0 ? (double)s->decrypted * 188. * 8. / (double)s->usec : 0.;
+}
+
+#endif
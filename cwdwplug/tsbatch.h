@@ -0,0 +1,237 @@
+#if !defined(__TSBATCH_H__)
+#define __TSBATCH_H__
+
+/* Batch classifier for TS packets.
+ *
+ * tsClassify decodes the headers of up to TS_BATCH_MAX packets at once: per
+ * packet the PID, the flags below, the scrambling control, the continuity
+ * counter and where its payload is, and per PID the packets that carry it.
+ * Where SSE2 is there the four header bytes of four packets are decoded in
+ * one go; the payload offsets, which depend on the adaptation field, and the
+ * grouping are scalar. The payload is found as the daemon's section filter
+ * always did it, the pointer field of a unit start skipped. The same file is
+ * in cwdwplug and eyetvCamd. */
+
+#include <stdint.h>
+#include <string.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define TS_BATCH_MAX   256   // packets per tsClassify call
+#define TS_BATCH_HASH  512   // power of two, above TS_BATCH_MAX
+#define TS_BATCH_PID_NONE  0x2000
+
+enum
+{
+  TS_SYNC       = 0x01,   // sync byte and no transport error
+  TS_START      = 0x02,   // payload_unit_start_indicator
+  TS_ADAPTATION = 0x04,   // has an adaptation field
+  TS_PAYLOAD    = 0x08    // has a payload
+};
+
+typedef struct
+{
+  uint16_t pid;
+  uint8_t flags;
+  uint8_t scrambling;     // transport_scrambling_control, 0 = clear
+  uint8_t continuity;
+  uint8_t payload;        // offset of the payload, 188 when there is none
+  int16_t payloadLen;     // 0 without payload, -1 for a broken packet
+} tsPacketInfo;
+
+typedef char tsPacketInfoSize[sizeof(tsPacketInfo) == 8 ? 1 : -1];
+
+typedef struct
+{
+  int count;
+  int unsynced;           // packets without TS_SYNC, not in any PID's list
+  tsPacketInfo info[TS_BATCH_MAX];
+  /* The PIDs in the order they first appear. The packets of pid[g] are
+   * index[first[g]] up to index[first[g + 1] - 1], in stream order. */
+  int pidCount;
+  uint16_t pid[TS_BATCH_MAX];
+  uint16_t first[TS_BATCH_MAX + 1];
+  uint16_t index[TS_BATCH_MAX];
+  uint16_t hash[TS_BATCH_HASH];   // group + 1 by PID, 0 = free
+} tsBatch;
+
+// the header fields, from its four bytes in stream order
+static inline void tsDecodeHeader(tsPacketInfo *p, const unsigned char *h)
+{
+  p->pid = ((h[1] & 0x1f) << 8) | h[2];
+  p->flags = (h[0] == 0x47 && (h[1] & 0x80) == 0 ? TS_SYNC : 0) |
+	     ((h[1] & 0x40) ? TS_START : 0) |
+	     ((h[3] & 0x20) ? TS_ADAPTATION : 0) |
+	     ((h[3] & 0x10) ? TS_PAYLOAD : 0);
+  p->scrambling = h[3] >> 6;
+  p->continuity = h[3] & 0x0f;
+  if( p->flags == (TS_SYNC | TS_PAYLOAD) )
+  {
+    p->payload = 4;
+    p->payloadLen = 184;
+  }
+  else
+  {
+    p->payload = 188;
+    p->payloadLen = 0;
+  }
+}
+
+/* payload and payloadLen, once the header is decoded; the header decode
+ * already did it for a packet that is all payload */
+static inline void tsFindPayload(tsPacketInfo *p, const unsigned char *pkt)
+{
+  int offset = 4, len = 184;
+
+  if( (pkt[1] & 0x80) || (p->flags & (TS_ADAPTATION | TS_PAYLOAD)) == 0 )
+  {
+    p->payloadLen = -1;   // transport error or reserved adaptation_field_control
+    return;
+  }
+  if( (p->flags & TS_PAYLOAD) == 0 )
+    return;
+  if( p->flags & TS_ADAPTATION )
+  {
+    offset += 1 + pkt[4];
+    len -= 1 + pkt[4];
+  }
+  if( len > 0 && (p->flags & TS_START) )
+  {
+    int additional = pkt[offset] + 1;
+    offset += additional;
+    len -= additional;
+  }
+  if( len < 0 )
+  {
+    p->payloadLen = -1;
+    return;
+  }
+  p->payload = len > 0 ? offset : 188;
+  p->payloadLen = len;
+}
+
+// one packet on its own
+static inline void tsClassifyPacket(tsPacketInfo *p, const unsigned char *pkt)
+{
+  tsDecodeHeader(p, pkt);
+  tsFindPayload(p, pkt);
+}
+
+#if defined(__SSE2__)
+/* Four headers at once. With the header bytes loaded little endian as
+ * b0 | b1 << 8 | b2 << 16 | b3 << 24 both halves of tsPacketInfo are
+ * computed as 32 bit lanes and interleaved into place. */
+static inline void tsDecodeHeaders4(tsPacketInfo *p, unsigned char *const *pkts)
+{
+  uint32_t w0, w1, w2, w3;
+  memcpy(&w0, pkts[0], 4);
+  memcpy(&w1, pkts[1], 4);
+  memcpy(&w2, pkts[2], 4);
+  memcpy(&w3, pkts[3], 4);
+  __m128i v = _mm_unpacklo_epi64(_mm_unpacklo_epi32(_mm_cvtsi32_si128(w0), _mm_cvtsi32_si128(w1)),
+				 _mm_unpacklo_epi32(_mm_cvtsi32_si128(w2), _mm_cvtsi32_si128(w3)));
+  __m128i sync = _mm_and_si128(_mm_cmpeq_epi32(_mm_and_si128(v, _mm_set1_epi32(0x80ff)), _mm_set1_epi32(0x47)),
+			       _mm_set1_epi32(TS_SYNC));
+  __m128i flags = _mm_or_si128(_mm_or_si128(sync,
+					    _mm_and_si128(_mm_srli_epi32(v, 13), _mm_set1_epi32(TS_START))),
+			       _mm_or_si128(_mm_and_si128(_mm_srli_epi32(v, 27), _mm_set1_epi32(TS_ADAPTATION)),
+					    _mm_and_si128(_mm_srli_epi32(v, 25), _mm_set1_epi32(TS_PAYLOAD))));
+  __m128i pid = _mm_or_si128(_mm_and_si128(v, _mm_set1_epi32(0x1f00)),
+			     _mm_and_si128(_mm_srli_epi32(v, 16), _mm_set1_epi32(0xff)));
+  __m128i lo = _mm_or_si128(_mm_or_si128(pid, _mm_slli_epi32(flags, 16)),
+			    _mm_slli_epi32(_mm_srli_epi32(v, 30), 24));
+  // continuity, and the payload of a packet without adaptation field or unit start
+  __m128i plain = _mm_cmpeq_epi32(flags, _mm_set1_epi32(TS_SYNC | TS_PAYLOAD));
+  __m128i hi = _mm_or_si128(_mm_and_si128(_mm_srli_epi32(v, 24), _mm_set1_epi32(0x0f)),
+			    _mm_or_si128(_mm_andnot_si128(plain, _mm_set1_epi32(188 << 8)),
+					 _mm_and_si128(plain, _mm_set1_epi32(4 << 8 | 184 << 16))));
+  _mm_storeu_si128((__m128i *)&p[0], _mm_unpacklo_epi32(lo, hi));
+  _mm_storeu_si128((__m128i *)&p[2], _mm_unpackhi_epi32(lo, hi));
+}
+#endif
+
+static inline void tsClassify(tsBatch *b, unsigned char *const *pkts, int count)
+{
+  uint16_t group[TS_BATCH_MAX];
+  uint16_t next[TS_BATCH_MAX];
+  int i = 0;
+
+  if( count > TS_BATCH_MAX )
+    count = TS_BATCH_MAX;
+  b->count = count;
+#if defined(__SSE2__)
+  for(; i + 4 <= count; i += 4)
+    tsDecodeHeaders4(&b->info[i], &pkts[i]);
+#endif
+  for(; i < count; i++)
+    tsDecodeHeader(&b->info[i], pkts[i]);
+
+  b->unsynced = 0;
+  b->pidCount = 0;
+  memset(b->hash, 0, sizeof(b->hash));
+  unsigned int lastPid = TS_BATCH_PID_NONE;
+  int lastGroup = 0;
+  int run = 0;            // packets of lastPid not counted in first[] yet
+  for(i = 0; i < count; i++)
+  {
+    tsPacketInfo *p = &b->info[i];
+    if( p->flags != (TS_SYNC | TS_PAYLOAD) )
+    {
+      tsFindPayload(p, pkts[i]);
+      if( (p->flags & TS_SYNC) == 0 )
+      {
+	group[i] = TS_BATCH_MAX;
+	b->unsynced++;
+	continue;
+      }
+    }
+    // mostly the same PID as the packet before
+    if( p->pid != lastPid )
+    {
+      if( run != 0 )
+	b->first[lastGroup] += run;
+      run = 0;
+      unsigned int h = (p->pid ^ (p->pid >> 9)) & (TS_BATCH_HASH - 1);
+      while( b->hash[h] != 0 && b->pid[b->hash[h] - 1] != p->pid )
+	h = (h + 1) & (TS_BATCH_HASH - 1);
+      if( b->hash[h] == 0 )
+      {
+	b->pid[b->pidCount] = p->pid;
+	b->first[b->pidCount] = 0;
+	b->hash[h] = ++b->pidCount;
+      }
+      lastPid = p->pid;
+      lastGroup = b->hash[h] - 1;
+    }
+    group[i] = lastGroup;
+    run++;
+  }
+  if( run != 0 )
+    b->first[lastGroup] += run;
+  // counts to starts
+  int start = 0;
+  for(int g = 0; g < b->pidCount; g++)
+  {
+    int n = b->first[g];
+    b->first[g] = next[g] = start;
+    start += n;
+  }
+  b->first[b->pidCount] = start;
+  int g = TS_BATCH_MAX, at = 0;
+  for(i = 0; i < count; i++)
+  {
+    if( group[i] == TS_BATCH_MAX )
+      continue;
+    if( group[i] != g )
+    {
+      if( g != TS_BATCH_MAX )
+	next[g] = at;
+      g = group[i];
+      at = next[g];
+    }
+    b->index[at++] = i;
+  }
+}
+
+#endif
@@ -5,15 +5,57 @@
 #import "emm.h"
 #import "SrvController.h"
 #import "sectionFilter.h"
+#include "tsring.h"
+#include "tsbatch.h"
+#include "cwslot.h"
+#include <pthread.h>
 
 #define NUM_DEVS 12
+#define NUM_PIDS 8192
+// EMM PIDs per device, from the CAT; multi-CAS CATs list a dozen or two,
+// the ones beyond this are logged and not filtered
+#define NUM_EMM_PIDS 32
+
+// microseconds between two parses of a PMT no ECM PID was chosen from
+#define PMT_RETRY 1000000
+
+// what a PID is to a device; one PID may be several, the first wins
+enum
+{
+  PID_PMT = 0x01,
+  PID_ECM = 0x02,
+  PID_CAT = 0x04,
+  PID_EMM = 0x08
+};
+
+typedef struct
+{
+  uint8_t role;                 // PID_ flags
+  uint8_t emm;                  // index in emmPids, with PID_EMM
+} pidEntry;
+
+typedef struct
+{
+  unsigned int pid;
+  emmDataState state;
+  NSMutableData *buffer;        // for EMMs that are assembled
+  sectionAssembler filter;
+} emmPidCtrl;
+
+/* Every device's packets are decoded on a thread of its own (drainRing),
+ * which holds lock while it does; the main thread takes it to look at or
+ * change the device. cwLock only covers what writeDwToDescrambler reads,
+ * it is taken from any thread and nothing else is locked under it. */
 typedef struct
 {
-  section *sPMT;
-  section *sECM;
-//  section *sEMM;
-  section *sCAT;
-  unsigned long curPmtPid;
+  pthread_mutex_t lock;         // recursive, the table view calls back into the controller
+  pthread_mutex_t cwLock;       // curServiceId, curCa and the cwSlot
+  sectionAssembler sPMT;
+  sectionAssembler sECM;
+  sectionAssembler sCAT;
+  sectionVersion vPMT;          // the PMT and CAT last parsed
+  sectionVersion vCAT;
+  unsigned long curPmtPid;      // set with setPmtPid / setEcmPid, which keep pids in step
   unsigned long curServiceId;
   unsigned long curTransponderId;
   unsigned long curEcmPid;
@@ -22,11 +64,10 @@ typedef struct
   cat * catSet;
   caDescriptor *curCa;
   unsigned char lastDW[16];
-//  emmDataState emmBufferState;
-//  NSMutableData *emmBuffer;
-  NSMutableDictionary *emmSectionFilter;
-  NSMutableDictionary *emmBuffer;
-  NSMutableDictionary *emmState;
+  pidEntry pids[NUM_PIDS];      // routing of the packets by PID
+  emmPidCtrl emmPids[NUM_EMM_PIDS];
+  int emmCount;
+  uint64_t pmtRetry;            // cwSlotNow() the PMT is parsed again at, while curEcmPid is 0
 } devCtrl;
 
 @interface Controller : NSObject
@@ -51,6 +92,11 @@ typedef struct
     NSOutputStream *mpgFile;
     NSMutableSet *emmReaders;
     NSMutableDictionary *recordPids;
+    tsring rings[NUM_DEVS];   // packets from the plugin, see tsring.h
+    cwSlot cwSlots[NUM_DEVS]; // control words to the plugin, see cwslot.h
+    pthread_rwlock_t caCacheLock;     // caCache and emmReaders change on the main thread
+    pthread_rwlock_t emmReadersLock;  // only, the device threads read them under these
+    pthread_mutex_t recordLock;       // recordPids
 }
 
 - (IBAction)selectedDevs:(id)sender;
@@ -73,18 +119,27 @@ typedef struct
 - (void)textToLog:(NSString *)logtext;
 - (void)awakeFromNib;
 - (void)tableViewSelectionDidChange:(NSNotification *)notification;
+- (void)selectCaRow:(int)row;
 - (void)writeDwToDescrambler:(unsigned char *)dw caDesc:(caDescriptor *)ca sid:(unsigned long)sid;
 - (void)emmAddParams:(unsigned char *)serial provData:(unsigned char *)bytes caid:(unsigned int)casys ident:(unsigned int)provid;
 - (void)emmRmParams:(unsigned char *)serial provData:(unsigned char *)bytes caid:(unsigned int)casys ident:(unsigned int)provid;
 - (void)irdetoChannelChange:(unsigned int)irdchn;
 - (void)srvListLoadConfig;
 - (void)decodePluginMessage:(NSArray *)msgData;
+- (void)decodePluginPacket:(unsigned char *)tsPacket dev:(int)idx;
+- (void)decodePid:(unsigned int)pid packets:(unsigned char **)pkts info:(const tsPacketInfo *)info index:(const uint16_t *)index count:(int)count dev:(int)idx;
+- (void)ringThreadStart:(NSNumber *)dev;
+- (void)drainRing:(int)idx;
+- (void)decodeRingBatch:(unsigned char **)pkts count:(int)count dev:(int)idx;
+- (void)showDevice:(NSNumber *)dev;
+- (void)recordSection:(const unsigned char *)data length:(unsigned int)len name:(NSString *)key;
 - (unsigned long)getNagraIdent:(NSData *)pEcm caDesc:(caDescriptor *)ca;
 - (unsigned long)getCworksIdent:(NSData *)pEcm caDesc:(caDescriptor *)ca;
 - (void)clearAllEmm:(int)devno;
 - (void)addEmmPid:(unsigned int)pid toDevice:(int)devno;
 - (void)stopAllEmmPids;
 - (void)startAllEmmPids;
+- (void)caSelectionChanged;
 
 @end
 
@@ -1,8 +1,9 @@
 #import "Controller.h"
 #include "messages.h"
-#include "dvbheader.h"
+#include "tsbatch.h"
 #include "globals.h"
 #include "aes1.h"
+#include "crc32.h"
 
 Controller *ctrl = nil;
 NSLock *logLocker = nil;
@@ -65,9 +66,30 @@ void ControllerDump(unsigned char *buf, int len)
 	[pData release];
 }
 
+// the PMT and ECM PID of a device, moved in its PID table along with them
+static void setPmtPid(devCtrl *pDev, unsigned long pid)
+{
+	pDev->pids[pDev->curPmtPid % NUM_PIDS].role &= ~PID_PMT;
+	pDev->pids[pid % NUM_PIDS].role |= PID_PMT;
+	pDev->curPmtPid = pid;
+}
+
+static void setEcmPid(devCtrl *pDev, unsigned long pid)
+{
+	pDev->pids[pDev->curEcmPid % NUM_PIDS].role &= ~PID_ECM;
+	pDev->pids[pid % NUM_PIDS].role |= PID_ECM;
+	pDev->curEcmPid = pid;
+}
+
 @implementation Controller
 - (void)textToLog:(NSString *)logtext
 {
+	// the device threads log as well, the view is the main thread's
+	if( [NSThread isMainThread] == NO )
+	{
+		[self performSelectorOnMainThread:@selector(textToLog:) withObject:logtext waitUntilDone:NO];
+		return;
+	}
 	float doScroll = [[[gdbView enclosingScrollView] verticalScroller] floatValue];
 	[gdbView replaceCharactersInRange:NSMakeRange([[gdbView textStorage] length], 0) withString:logtext];
 	if( doScroll == 1.0 )
@@ -93,394 +115,437 @@ void ControllerDump(unsigned char *buf, int len)
 				return;
 			}
 		}
-		devCtrl *pDev = &devs[idx];
 		if( pmsg != nil )
 		{
-			unsigned char *tsPacket = (unsigned char *)[pmsg bytes]; 
-			TSHeader rcv;
-			rcv.word = ntohl(*(unsigned int *)tsPacket); 
+			pthread_mutex_lock(&devs[idx].lock);
+			[self decodePluginPacket:(unsigned char *)[pmsg bytes] dev:idx];
+			pthread_mutex_unlock(&devs[idx].lock);
+		}
+	}
+}
+
+- (void)decodePluginPacket:(unsigned char *)tsPacket dev:(int)idx
+{
+	devCtrl *pDev = &devs[idx];
+	unsigned int msgType = ntohl(*(unsigned int *)tsPacket);
+	
+	switch( msgType )
+	{
+		case msg_new_channel:
+		{
+			[pDev->pmtSet clearList];
+			if( selectedDevice == idx )
+			{
+				pDev->selected = -1;
+				[self performSelectorOnMainThread:@selector(showDevice:) withObject:[NSNumber numberWithInt:idx] waitUntilDone:NO];
+				[irdCtl clearValid:idx];
+			}
+			msgNewChannel *pch = (msgNewChannel *)tsPacket;
+			unsigned long newTransponderId = ntohl(pch->mTransponder);
+			if( newTransponderId != pDev->curTransponderId )
+			{
+				pDev->sCAT.reset();
+				pDev->vCAT.reset();
+				msgPid filterPid;
+				filterPid.id = msg_add_pid;
+				filterPid.mPid = htonl(1); // CAT pid is always 1
+				NSMutableData *pmsg = [[NSMutableData alloc] init];
+				[pmsg appendBytes:&filterPid length:sizeof(filterPid)];
+				[self sendData:pmsg dev:idx];
+				[pmsg release];
+			}
+			pDev->curTransponderId = newTransponderId;
+			pthread_mutex_lock(&pDev->cwLock);
+			pDev->curServiceId = ntohl(pch->mService);
+			pthread_mutex_unlock(&pDev->cwLock);
+			setPmtPid(pDev, ntohl(pch->mPmt));
+			setEcmPid(pDev, 0);     // chosen again from the new PMT
+			pDev->sPMT.reset();
+			pDev->vPMT.reset();
+			pDev->sECM.reset();
+			msgPid filterPid;
+			filterPid.id = msg_add_pid;
+			filterPid.mPid = htonl(pDev->curPmtPid);
+			NSMutableData *pmsg = [[NSMutableData alloc] init];
+			[pmsg appendBytes:&filterPid length:sizeof(filterPid)];
+			[self sendData:pmsg dev:idx];
+			[pmsg release];
+		} break;
+		case msg_initialized:
+			pDev->curTransponderId = 0;
+			pthread_mutex_lock(&pDev->cwLock);
+			pDev->curServiceId = 0;
+			pthread_mutex_unlock(&pDev->cwLock);
+			setPmtPid(pDev, 0);
+			setEcmPid(pDev, 0);
+			break;
+		case msg_termitate:
+			pDev->curTransponderId = 0;
+			pthread_mutex_lock(&pDev->cwLock);
+			pDev->curServiceId = 0;
+			pthread_mutex_unlock(&pDev->cwLock);
+			setPmtPid(pDev, 0);
+			setEcmPid(pDev, 0);
+			break;
 			
-			switch( rcv.word )
+		default:
+		{
+			tsPacketInfo info;
+			tsClassifyPacket(&info, tsPacket);
+			if( info.flags & TS_SYNC ) // DVB Packet w/o ts error
 			{
-				case msg_new_channel:
-				{
-					[pDev->pmtSet clearList];
-					if( selectedDevice == idx )
-					{
-						pDev->selected = -1;
-						[caDescList reloadData];
-						[irdCtl clearValid:idx];
-					}
-					msgNewChannel *pch = (msgNewChannel *)[pmsg bytes];
-					unsigned long newTransponderId = ntohl(pch->mTransponder);
-					if( newTransponderId != pDev->curTransponderId )
-					{
-						[pDev->sCAT reset];
-						msgPid filterPid;
-						filterPid.id = msg_add_pid;
-						filterPid.mPid = htonl(1); // CAT pid is always 1
-						NSMutableData *pmsg = [[NSMutableData alloc] init];
-						[pmsg appendBytes:&filterPid length:sizeof(filterPid)];
-						[self sendData:pmsg dev:idx];
-						[pmsg release];
-					}
-					pDev->curTransponderId = newTransponderId;
-					pDev->curServiceId = ntohl(pch->mService);
-					pDev->curPmtPid = ntohl(pch->mPmt);
-					[pDev->sPMT reset];
-					[pDev->sECM reset];
-					msgPid filterPid;
-					filterPid.id = msg_add_pid;
-					filterPid.mPid = htonl(pDev->curPmtPid);
-					NSMutableData *pmsg = [[NSMutableData alloc] init];
-					[pmsg appendBytes:&filterPid length:sizeof(filterPid)];
-					[self sendData:pmsg dev:idx];
-					[pmsg release];
-				} break;
-				case msg_initialized:
-					pDev->curTransponderId = 0;
-					pDev->curServiceId = 0;
-					pDev->curPmtPid = 0;
-					pDev->curEcmPid = 0;
-					break;
-				case msg_termitate:
-					pDev->curTransponderId = 0;
-					pDev->curServiceId = 0;
-					pDev->curPmtPid = 0;
-					pDev->curEcmPid = 0;
-					break;
-					
-				default:
+				uint16_t first = 0;
+				[self decodePid:info.pid packets:&tsPacket info:&info index:&first count:1 dev:idx];
+			}
+		}
+	}
+}
+
+/* The packets of one PID, pkts[index[0]] up to pkts[index[count - 1]] with
+ * info as tsClassify found it, are routed together: the PID is looked up
+ * in the device's PID table once for all of them. */
+- (void)decodePid:(unsigned int)pid packets:(unsigned char **)pkts info:(const tsPacketInfo *)info index:(const uint16_t *)index count:(int)count dev:(int)idx
+{
+	devCtrl *pDev = &devs[idx];
+	pidEntry route = pDev->pids[pid % NUM_PIDS];
+	if( route.role & PID_PMT )
+	{
+		for( int n = 0; n < count; n++ )
+		{
+			unsigned char *tsPacket = pkts[index[n]];
+			if( pDev->sPMT.toStream(tsPacket, &info[index[n]]) )
+			{
+				sectionView v;
+				while( pDev->sPMT.nextSection(&v) )
 				{
-					if( rcv.ts.syncByte == 0x47 && rcv.ts.transportErr == 0 ) // DVB Packet w/o ts error
+					const unsigned char *pmtPacket = v.data;
+					if( pmtPacket[0] == 0x2 ) // PMT Table ID
 					{
-						unsigned int pid = rcv.ts.pid;
-						if( pid == pDev->curPmtPid )
+						unsigned int pmtLen = (((pmtPacket[1] & 0xf) << 8) | (pmtPacket[2] & 0xff)) + 3;
+						unsigned int pmtSid = (pmtPacket[3] << 8) | pmtPacket[4];
+						/* Parsed again only when it changes, the PMT repeats every 100 ms or
+						 * so, or when what the choice of CA depends on changes (see
+						 * -caSelectionChanged). Without an ECM PID from it, once per
+						 * PMT_RETRY as well. */
+						bool fresh = pmtLen > 16 && pmtSid == pDev->curServiceId && pDev->vPMT.changed(&v);
+						bool retry = fresh == false && pmtLen > 16 && pmtSid == pDev->curServiceId &&
+							pDev->curEcmPid == 0 && [pDev->pmtSet caDescCount] > 0 &&
+							cwSlotNow() >= pDev->pmtRetry && crc32SectionValid(v.data, v.length);
+						if( fresh || retry )
 						{
-							if( [pDev->sPMT toStream:tsPacket] == statePayloadFull )
+							pDev->pmtRetry = cwSlotNow() + PMT_RETRY;
+							if( getShowCwDw() == YES )
 							{
-								do
+								ControllerLog("Received PMT:\n");
+								ControllerDump((unsigned char *)v.data, v.length);
+							}
+							[pDev->pmtSet parsePmtPayload:v.data length:v.length];
+							caDescriptor *ca = [[caDescriptor alloc] initStaticWithEcmpid:0 casys:0 ident:0];
+							int msgid = (pDev->curPmtPid << 16) | (pDev->curServiceId & 0xffff);
+							[ca setMessageId:msgid];
+							// the main thread may change the entry, it is copied under the lock
+							pthread_rwlock_rdlock(&caCacheLock);
+							caDescriptor *found = [caCache member:ca];
+							if( found != nil )
+							{
+								[ca setEcmpid:[found getEcmpid] casys:[found getCasys] ident:[found getIdent]];
+								[ca setIrdetoChannel:[found getIrdetoChannel]];
+								found = ca;
+							}
+							pthread_rwlock_unlock(&caCacheLock);
+							pDev->selected = 0;
+						
+							if ((found == nil) && (srvListCtl != nil))
+							{
+								NSArray *List = [pDev->pmtSet getCaDescriptors];
+								unsigned int caCount = [List count];
+								if( caCount > 0 )
 								{
-									unsigned char *pmtPacket = (unsigned char *)[pDev->sPMT getBuffer];
-									if( pmtPacket[0] == 0x2 ) // PMT Table ID
+									for( int i = 0; i < caCount; i++ )
 									{
-										unsigned int pmtLen = (((pmtPacket[1] & 0xf) << 8) | (pmtPacket[2] & 0xff)) + 3;
-										unsigned int pmtSid = (pmtPacket[3] << 8) | pmtPacket[4];
-										if( pmtLen > 16 && pmtSid == pDev->curServiceId )
-										{
-											if( getShowCwDw() == YES )
-											{
-												ControllerLog("Received PMT:\n");
-												ControllerDump([pDev->sPMT getData]);
-											}
-											[pDev->pmtSet parsePmtPayload:[pDev->sPMT getData]];
-											caDescriptor *ca = [[caDescriptor alloc] initStaticWithEcmpid:0 casys:0 ident:0];
-											int msgid = (pDev->curPmtPid << 16) | (pDev->curServiceId & 0xffff);
-											[ca setMessageId:msgid];
-											caDescriptor *found = [caCache member:ca];
-											pDev->selected = 0;
-											
-											if ((found == nil) && (srvListCtl != nil))
-											{
-												NSArray *List = [pDev->pmtSet getCaDescriptors];
-												unsigned int caCount = [List count];
-												if( caCount > 0 )
-												{
-													for( int i = 0; i < caCount; i++ )
-													{
-														caDescriptor *desc = [List objectAtIndex:i];
-														if ([srvListCtl hasCasys:[desc getCasys] Ident:[desc getIdent]])
-														{
-															found = desc;
-															break;
-														}
-													}
-												}
-											}
-											
-											if( found != nil )
-											{
-												[ca setMessageId:0];
-												[ca setEcmpid:[found getEcmpid] casys:[found getCasys] ident:[found getIdent]];
-												[irdCtl setIrdetoChannel:[found getIrdetoChannel] forDev:idx];
-												pDev->selected = [[pDev->pmtSet getCaDescriptors] indexOfObject:ca];
-												if( pDev->selected == NSNotFound || pDev->selected >= [pDev->pmtSet caDescCount] )
-												{
-													pDev->selected = 0;
-												}
-												else
-												{
-													pDev->curEcmPid = [ca getEcmpid];
-													if( selectedDevice != idx )
-													{
-														msgPid filterPid;
-														filterPid.id = msg_add_pid;
-														filterPid.mPid = htonl(pDev->curEcmPid);
-														NSMutableData *pmsg = [[NSMutableData alloc] init];
-														[pmsg appendBytes:&filterPid length:sizeof(filterPid)];
-														[self sendData:pmsg dev:idx];
-														[pmsg release];
-													}
-												}
-											}
-											if( selectedDevice == idx )
-											{
-												pmtChanged = YES;
-												[caDescList reloadData];
-												[caDescList selectRowIndexes:[NSIndexSet indexSetWithIndex:pDev->selected] byExtendingSelection:NO]; 
-												pmtChanged = NO;
-											}
-											[ca release];
-											[self clearAllEmm:idx];
-											unsigned int emmCaCount = [pDev->catSet caDescCount];
-											if( emmCaCount != 0 )
-											{
-												caDescriptor *desc = [[pDev->pmtSet getCaDescriptors] objectAtIndex:pDev->selected];
-												NSArray *List = [pDev->catSet getCaDescriptors];
-												for( int i = 0; i < emmCaCount; i++ )
-												{
-													id obj = [List objectAtIndex:i];
-													if( [obj getCasys] == [desc getCasys] )
-													{
-														unsigned int emmPid = [obj getEcmpid];
-														[self addEmmPid:emmPid toDevice:idx];
-														if( getEmmEnable() == YES )
-														{
-															msgPid filterPid;
-															filterPid.id = msg_add_pid;
-															filterPid.mPid = htonl(emmPid);
-															NSMutableData *pmsg = [[NSMutableData alloc] init];
-															[pmsg appendBytes:&filterPid length:sizeof(filterPid)];
-															[self sendData:pmsg dev:idx];
-															ControllerLog("EMM Processing: caid:%x emmpid:%x\n",[desc getCasys], emmPid);
-														}
-													}
-												}
-											}
-										}
-										else
+										caDescriptor *desc = [List objectAtIndex:i];
+										if ([srvListCtl hasCasys:[desc getCasys] Ident:[desc getIdent]])
 										{
-											[pDev->sPMT reset];
+											found = desc;
+											break;
 										}
 									}
-								} while( [pDev->sPMT nextSection] == YES );
+								}
 							}
-						}
-						else if( pid == pDev->curEcmPid )
-						{
-							if( [pDev->sECM toStream:tsPacket] == statePayloadFull )
+						
+							if( found != nil )
 							{
-								int row = pDev->selected;
-								int rowCount = [[pDev->pmtSet getCaDescriptors] count];
-								decryptFlag dmode = DECRYPT_MODE_NONE;
-								do
+								[ca setMessageId:0];
+								[ca setEcmpid:[found getEcmpid] casys:[found getCasys] ident:[found getIdent]];
+								[irdCtl setIrdetoChannel:[found getIrdetoChannel] forDev:idx];
+								pDev->selected = [[pDev->pmtSet getCaDescriptors] indexOfObject:ca];
+								if( pDev->selected == NSNotFound || pDev->selected >= [pDev->pmtSet caDescCount] )
 								{
-									unsigned char *ecmPacket = [pDev->sECM getBuffer];
-									if( ecmPacket[0] == 0x80 || ecmPacket[0] == 0x81 ) // ECM Table ID
+									pDev->selected = 0;
+								}
+								else
+								{
+									setEcmPid(pDev, [ca getEcmpid]);
+									if( selectedDevice != idx )
 									{
-										unsigned int pLen = (((ecmPacket[1] & 0xf) << 8) | (ecmPacket[2] & 0xff)) + 3;
-										NSData *showEcm = [[NSData alloc] initWithBytes:ecmPacket length:pLen];
-										unsigned int ecmLen = (((ecmPacket[1] & 0xf) << 8) | (ecmPacket[2] & 0xff)) + 3;
-										if( ecmLen <= [[pDev->sECM getData] length] )
-										{
-											NSData *pEcm = [[NSData alloc] initWithBytes:ecmPacket length:ecmLen];
-											if( row !=  -1 && rowCount > row )
-											{
-												caDescriptor *desc = [[pDev->pmtSet getCaDescriptors] objectAtIndex:row];
-												unsigned long ident = 0;
-												unsigned int casysBase = [pDev->curCa getCasys] & 0xff00;
-												if( casysBase == 0x1800 )
-												{
-													ident = [self getNagraIdent:pEcm caDesc:desc];
-												}
-												if( casysBase == 0x0d00 )
-												{
-													ident = [self getCworksIdent:pEcm caDesc:desc];
-												}
-												if( casysBase == 0x0600 )
-												{
-													
-												}
-												if( ident != 0 )
-												{
-													[desc setEcmpid:[desc getEcmpid] casys:[desc getCasys] ident:ident];
-												}
-												[pDev->curCa setEcmpid:[desc getEcmpid] casys:[desc getCasys] ident:[desc getIdent]];
-												
-												[desc setDmode:dmode];
-												[pDev->curCa setDmode:dmode];
-												[srvListCtl sendEcmPacket:pEcm Cadesc:desc Ssid:pDev->curServiceId devIndex:idx];
-											}
-											[pEcm release];
-										}
-										[showEcm release];
-										
-										if( getRawRecordState() == YES )
-										{
-											NSString *key = [[NSString alloc] initWithFormat:@"dev%dECMPid.0x%x",idx, [pDev->sECM getPid]];
-											BOOL fileRelease = NO;
-											NSOutputStream *file = [recordPids objectForKey:key];
-											if( file == 0 )
-											{
-												NSString *path = [[[docPath stringByExpandingTildeInPath] stringByAppendingPathComponent:@"record"] 
-																  stringByAppendingPathComponent:key];
-												file = [[NSOutputStream alloc] initToFileAtPath:path append:YES];
-												[file open];
-												[recordPids setObject:file forKey:key];
-												fileRelease = YES;
-											}
-											[file write:[pDev->sECM getBuffer] maxLength:[[pDev->sECM getData] length]];
-											if( fileRelease == YES )
-											{
-												[file release];
-											}
-											[key release];
-										}
+										msgPid filterPid;
+										filterPid.id = msg_add_pid;
+										filterPid.mPid = htonl(pDev->curEcmPid);
+										NSMutableData *pmsg = [[NSMutableData alloc] init];
+										[pmsg appendBytes:&filterPid length:sizeof(filterPid)];
+										[self sendData:pmsg dev:idx];
+										[pmsg release];
 									}
-								} while( [pDev->sECM nextSection] == YES );
-								[pDev->sECM reset];
+								}
 							}
-						}
-						else if( pid == 1 )  // CAT received
-						{
-							if( [pDev->sCAT toStream:tsPacket] == statePayloadFull )
+							if( selectedDevice == idx )
+							{
+								[self performSelectorOnMainThread:@selector(showDevice:) withObject:[NSNumber numberWithInt:idx] waitUntilDone:NO];
+							}
+							[ca release];
+							// a retry that chose nothing leaves the EMM PIDs as they are
+							unsigned int emmCaCount = [pDev->catSet caDescCount];
+							if( fresh == false && pDev->curEcmPid == 0 )
+							{
+								emmCaCount = 0;
+							}
+							else
 							{
-								[pDev->catSet parseCATPayload:[pDev->sCAT getData]];
 								[self clearAllEmm:idx];
-								int emmCaCount = [pDev->catSet caDescCount];
-								if( emmCaCount != 0 && [pDev->pmtSet caDescCount] != 0 )
+							}
+							if( emmCaCount != 0 )
+							{
+								caDescriptor *desc = [[pDev->pmtSet getCaDescriptors] objectAtIndex:pDev->selected];
+								NSArray *List = [pDev->catSet getCaDescriptors];
+								for( int i = 0; i < emmCaCount; i++ )
 								{
-									caDescriptor *desc = [[pDev->pmtSet getCaDescriptors] objectAtIndex:pDev->selected];
-									NSArray *List = [pDev->catSet getCaDescriptors];
-									for( int i = 0; i < emmCaCount; i++ )
+									id obj = [List objectAtIndex:i];
+									if( [obj getCasys] == [desc getCasys] )
 									{
-										id obj = [List objectAtIndex:i];
-										if( [obj getCasys] == [desc getCasys] )
+										unsigned int emmPid = [obj getEcmpid];
+										[self addEmmPid:emmPid toDevice:idx];
+										if( getEmmEnable() == YES )
 										{
-											unsigned int emmPid = [obj getEcmpid];
-											[self addEmmPid:emmPid toDevice:idx];
-											if( getEmmEnable() == YES )
-											{
-												msgPid filterPid;
-												filterPid.id = msg_add_pid;
-												filterPid.mPid = htonl(emmPid);
-												NSMutableData *pmsg = [[NSMutableData alloc] init];
-												[pmsg appendBytes:&filterPid length:sizeof(filterPid)];
-												[self sendData:pmsg dev:idx];
-												ControllerLog("EMM Processing: caid:%x emmpid:%x\n",[desc getCasys], emmPid);
-											}
+											msgPid filterPid;
+											filterPid.id = msg_add_pid;
+											filterPid.mPid = htonl(emmPid);
+											NSMutableData *pmsg = [[NSMutableData alloc] init];
+											[pmsg appendBytes:&filterPid length:sizeof(filterPid)];
+											[self sendData:pmsg dev:idx];
+											ControllerLog("EMM Processing: caid:%x emmpid:%x\n",[desc getCasys], emmPid);
 										}
 									}
 								}
 							}
 						}
-						else // emm received
+					}
+				}
+			}
+		}
+	}
+	else if( route.role & PID_ECM )
+	{
+		for( int n = 0; n < count; n++ )
+		{
+			unsigned char *tsPacket = pkts[index[n]];
+			if( pDev->sECM.toStream(tsPacket, &info[index[n]]) )
+			{
+				int row = pDev->selected;
+				int rowCount = [[pDev->pmtSet getCaDescriptors] count];
+				decryptFlag dmode = DECRYPT_MODE_NONE;
+				sectionView v;
+				while( pDev->sECM.nextSection(&v) )
+				{
+					const unsigned char *ecmPacket = v.data;
+					if( ecmPacket[0] == 0x80 || ecmPacket[0] == 0x81 ) // ECM Table ID
+					{
+						unsigned int ecmLen = (((ecmPacket[1] & 0xf) << 8) | (ecmPacket[2] & 0xff)) + 3;
+						if( ecmLen <= v.length )
 						{
-							NSNumber *key = [[NSNumber alloc] initWithUnsignedInt:pid];
-							section *sEmm = [pDev->emmSectionFilter objectForKey:key];
-							NSNumber *emmStateRef = [pDev->emmState objectForKey:key];
-							NSMutableData *emmAssembleBuffer = [pDev->emmBuffer objectForKey:key];
-							if( getEmmEnable() == YES && sEmm != nil && emmStateRef != nil && emmAssembleBuffer != nil )
+							NSData *pEcm = [[NSData alloc] initWithBytes:ecmPacket length:ecmLen];
+							if( row !=  -1 && rowCount > row )
 							{
-								if( [sEmm toStream:tsPacket] == statePayloadFull )
+								caDescriptor *desc = [[pDev->pmtSet getCaDescriptors] objectAtIndex:row];
+								unsigned long ident = 0;
+								unsigned int casysBase = [pDev->curCa getCasys] & 0xff00;
+								if( casysBase == 0x1800 )
 								{
-									do
-									{
-										unsigned int curEmmPid = [sEmm getPid];
-										unsigned int curCaid = [[[pDev->pmtSet getCaDescriptors] objectAtIndex:pDev->selected] getCasys];
-										NSEnumerator *emmDescriptors = [[pDev->catSet getCaDescriptors] objectEnumerator];
-										caDescriptor *emmDesc = nil;
-										while( ( emmDesc = [emmDescriptors nextObject] ) != nil )
-										{	// we need to match both the emmPid and the curent CAID as some feed have 3 or more CAID using the same emmPid
-											// if we only match on the emmPid we only get the 1st caid and it might not be the right one.
-											if( [emmDesc getEcmpid] == curEmmPid && [emmDesc getCasys] == curCaid)
-											{
-												break;
-											}
-										}
-
-										if( emmDesc != nil )
-										{
-											caDescriptor *ecmDesc = [[pDev->pmtSet getCaDescriptors] objectAtIndex:pDev->selected];
-											NSEnumerator *emms = [emmReaders objectEnumerator];
-											emmParams *paramsObj = nil;
-											while( (paramsObj = [emms nextObject]) != 0 )
-											{
-												// test that the emm is for the current provider except for nagra.. where apaprently the emm
-												// can be on a different provid than the one selected.
-												if( ([paramsObj getCaid] == [emmDesc getCasys] && [paramsObj getIdent] == [ecmDesc getIdent]) ||
-													([paramsObj getCaid] == [emmDesc getCasys] && ([paramsObj getCaid] & 0xff00) == NAGRA_CA_SYSTEM) )
-												{
-													if( ([paramsObj getCaid] & 0xff00) != IRDETO_CA_SYSTEM && ([paramsObj getCaid] & 0xff00) != BETA_CA_SYSTEM )
-													{
-														break;
-													}
-													else
-													{
-														unsigned char *provData = [paramsObj getProviderData];
-														if( provData[5] != 0x1f && provData[6] != 0xff && provData[7] != 0xff )
-														{
-															break;
-														}
-													}
-												}
-											}
+									ident = [self getNagraIdent:pEcm caDesc:desc];
+								}
+								if( casysBase == 0x0d00 )
+								{
+									ident = [self getCworksIdent:pEcm caDesc:desc];
+								}
+								if( casysBase == 0x0600 )
+								{
+								
+								}
+								if( ident != 0 )
+								{
+									[desc setEcmpid:[desc getEcmpid] casys:[desc getCasys] ident:ident];
+								}
+								pthread_mutex_lock(&pDev->cwLock);
+								[pDev->curCa setEcmpid:[desc getEcmpid] casys:[desc getCasys] ident:[desc getIdent]];
+							
+								[desc setDmode:dmode];
+								[pDev->curCa setDmode:dmode];
+								pthread_mutex_unlock(&pDev->cwLock);
+								[srvListCtl sendEcmPacket:pEcm Cadesc:desc Ssid:pDev->curServiceId devIndex:idx];
+							}
+							[pEcm release];
+						}
+					
+						if( getRawRecordState() == YES )
+						{
+							NSString *key = [[NSString alloc] initWithFormat:@"dev%dECMPid.0x%x",idx, pDev->sECM.getPid()];
+							[self recordSection:v.data length:v.length name:key];
+							[key release];
+						}
+					}
+				}
+			}
+		}
+	}
+	else if( route.role & PID_CAT )
+	{
+		for( int n = 0; n < count; n++ )
+		{
+			unsigned char *tsPacket = pkts[index[n]];
+			if( pDev->sCAT.toStream(tsPacket, &info[index[n]]) )
+			{
+				sectionView v;
+				while( pDev->sCAT.nextSection(&v) )
+				{
+					// the first section, parsed again only when it changes
+					if( v.data[0] != 0x1 || v.length < 12 || v.data[6] != 0 || pDev->vCAT.changed(&v) == NO )
+					{
+						continue;
+					}
+					[pDev->catSet parseCATPayload:v.data length:v.length];
+					[self clearAllEmm:idx];
+					int emmCaCount = [pDev->catSet caDescCount];
+					if( emmCaCount != 0 && [pDev->pmtSet caDescCount] != 0 )
+					{
+						caDescriptor *desc = [[pDev->pmtSet getCaDescriptors] objectAtIndex:pDev->selected];
+						NSArray *List = [pDev->catSet getCaDescriptors];
+						for( int i = 0; i < emmCaCount; i++ )
+						{
+							id obj = [List objectAtIndex:i];
+							if( [obj getCasys] == [desc getCasys] )
+							{
+								unsigned int emmPid = [obj getEcmpid];
+								[self addEmmPid:emmPid toDevice:idx];
+								if( getEmmEnable() == YES )
+								{
+									msgPid filterPid;
+									filterPid.id = msg_add_pid;
+									filterPid.mPid = htonl(emmPid);
+									NSMutableData *pmsg = [[NSMutableData alloc] init];
+									[pmsg appendBytes:&filterPid length:sizeof(filterPid)];
+									[self sendData:pmsg dev:idx];
+									ControllerLog("EMM Processing: caid:%x emmpid:%x\n",[desc getCasys], emmPid);
+								}
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+	else if( route.role & PID_EMM )
+	{
+		emmPidCtrl *pEmmPid = &pDev->emmPids[route.emm];
+		sectionAssembler *sEmm = &pEmmPid->filter;
+		NSMutableData *emmAssembleBuffer = pEmmPid->buffer;
+		if( getEmmEnable() == YES )
+		{
+			for( int n = 0; n < count; n++ )
+			{
+				unsigned char *tsPacket = pkts[index[n]];
+				if( sEmm->toStream(tsPacket, &info[index[n]]) )
+				{
+					sectionView v;
+					while( sEmm->nextSection(&v) )
+					{
+						unsigned int curEmmPid = sEmm->getPid();
+						unsigned int curCaid = [[[pDev->pmtSet getCaDescriptors] objectAtIndex:pDev->selected] getCasys];
+						NSEnumerator *emmDescriptors = [[pDev->catSet getCaDescriptors] objectEnumerator];
+						caDescriptor *emmDesc = nil;
+						while( ( emmDesc = [emmDescriptors nextObject] ) != nil )
+						{	// we need to match both the emmPid and the curent CAID as some feed have 3 or more CAID using the same emmPid
+							// if we only match on the emmPid we only get the 1st caid and it might not be the right one.
+							if( [emmDesc getEcmpid] == curEmmPid && [emmDesc getCasys] == curCaid)
+							{
+								break;
+							}
+						}
 
-											if( paramsObj != nil )
-											{
-												emmDataState currentState = (emmDataState)[emmStateRef intValue];
-												emmDataState emmBufferState = processEmmData([sEmm getBuffer], paramsObj, 
-																							 emmAssembleBuffer, currentState);
-												switch(emmBufferState)
-												{
-													case emmStateReady:
-														[srvListCtl sendEmmPacket:[sEmm getData] Params:paramsObj];
-														break;
-													case emmStateReadyUseParams:
-														[srvListCtl sendEmmPacket:emmAssembleBuffer Params:paramsObj];
-														break;
-												}
-												if( currentState == via8cdReceived && emmBufferState == emmStateReady )
-												{
-													emmBufferState = via8cdReceived;
-												}
-												if( currentState == cryptoworks84Received && emmBufferState == emmStateReady )
-												{
-													emmBufferState = cryptoworks84Received;
-												}
-												NSNumber *newState = [[NSNumber alloc] initWithInt:(int)emmBufferState];
-												[pDev->emmState setObject:newState forKey:key];
-												[newState release];
-											}
-										}
-										if( getRawRecordState() == YES )
+						if( emmDesc != nil )
+						{
+							caDescriptor *ecmDesc = [[pDev->pmtSet getCaDescriptors] objectAtIndex:pDev->selected];
+							pthread_rwlock_rdlock(&emmReadersLock);
+							NSEnumerator *emms = [emmReaders objectEnumerator];
+							emmParams *paramsObj = nil;
+							while( (paramsObj = [emms nextObject]) != 0 )
+							{
+								// test that the emm is for the current provider except for nagra.. where apaprently the emm
+								// can be on a different provid than the one selected.
+								if( ([paramsObj getCaid] == [emmDesc getCasys] && [paramsObj getIdent] == [ecmDesc getIdent]) ||
+									([paramsObj getCaid] == [emmDesc getCasys] && ([paramsObj getCaid] & 0xff00) == NAGRA_CA_SYSTEM) )
+								{
+									if( ([paramsObj getCaid] & 0xff00) != IRDETO_CA_SYSTEM && ([paramsObj getCaid] & 0xff00) != BETA_CA_SYSTEM )
+									{
+										break;
+									}
+									else
+									{
+										unsigned char *provData = [paramsObj getProviderData];
+										if( provData[5] != 0x1f && provData[6] != 0xff && provData[7] != 0xff )
 										{
-											NSString *fkey = [[NSString alloc] initWithFormat:@"dev%dEMMPid.0x%x",idx, [sEmm getPid]];
-											BOOL fileRelease = NO;
-											NSOutputStream *file = [recordPids objectForKey:fkey];
-											if( file == 0 )
-											{ 
-												NSString *path = [[[docPath stringByExpandingTildeInPath] stringByAppendingPathComponent:@"record"] 
-																  stringByAppendingPathComponent:fkey];
-												file = [[NSOutputStream alloc] initToFileAtPath:path append:YES];
-												[file open];
-												[recordPids setObject:file forKey:fkey];
-												fileRelease = YES;
-											}
-											[file write:[sEmm getBuffer] maxLength:[[sEmm getData] length]];
-											if( fileRelease == YES )
-											{
-												[file release];
-											}
-											[fkey release];
+											break;
 										}
-									} while( [sEmm nextSection] == YES );
-								} 
-								[sEmm reset];
-								
-								[key release];
+									}
+								}
+							}
+							// kept past the lock, a server may take the reader away meanwhile
+							[paramsObj retain];
+							pthread_rwlock_unlock(&emmReadersLock);
+
+							if( paramsObj != nil )
+							{
+								emmDataState currentState = pEmmPid->state;
+								emmDataState emmBufferState = processEmmData((unsigned char *)v.data, paramsObj, 
+																			 emmAssembleBuffer, currentState);
+								switch(emmBufferState)
+								{
+									case emmStateReady:
+									{
+										NSData *pEmm = [[NSData alloc] initWithBytes:v.data length:v.length];
+										[srvListCtl sendEmmPacket:pEmm Params:paramsObj];
+										[pEmm release];
+									} break;
+									case emmStateReadyUseParams:
+										[srvListCtl sendEmmPacket:emmAssembleBuffer Params:paramsObj];
+										break;
+								}
+								if( currentState == via8cdReceived && emmBufferState == emmStateReady )
+								{
+									emmBufferState = via8cdReceived;
+								}
+								if( currentState == cryptoworks84Received && emmBufferState == emmStateReady )
+								{
+									emmBufferState = cryptoworks84Received;
+								}
+								pEmmPid->state = emmBufferState;
+								[paramsObj release];
 							}
 						}
+						if( getRawRecordState() == YES )
+						{
+							NSString *fkey = [[NSString alloc] initWithFormat:@"dev%dEMMPid.0x%x",idx, sEmm->getPid()];
+							[self recordSection:v.data length:v.length name:fkey];
+							[fkey release];
+						}
 					}
 				}
 			}
@@ -532,6 +597,10 @@ void ControllerDump(unsigned char *buf, int len)
 														  object:nil];
 #endif
 	[irdCtl setDelegateObj:self];
+	for( int i = 0; i < NUM_DEVS; i++ )
+	{
+		cwSlotOpen(&cwSlots[i], i);
+	}
 	// send cwdwplug alive message
 	typeOnlyMessage ca;
 	ca.id = msg_camd_online;
@@ -586,59 +655,92 @@ void ControllerDump(unsigned char *buf, int len)
 	{
 		[edEmmProcessing setTitle:@"Disable EMM"];
 	}
-	
+#if !defined(USE_NSPORT_IPC)
+	// the plugin falls back to the notification when it can't use a ring; the
+	// threads come last, they decode right away and may run the emulation
+	for( int i = 0; i < NUM_DEVS; i++ )
+	{
+		if( tsringOpen(&rings[i], i) == true )
+		{
+			tsringFlush(&rings[i]);
+			[NSThread detachNewThreadSelector:@selector(ringThreadStart:) toTarget:self withObject:[NSNumber numberWithInt:i]];
+		}
+	}
+#endif
 }
 
 - (int)numberOfRowsInTableView:(NSTableView *)tableView
 {
-	return [devs[selectedDevice].pmtSet caDescCount];
+	pthread_mutex_lock(&devs[selectedDevice].lock);
+	int rows = [devs[selectedDevice].pmtSet caDescCount];
+	pthread_mutex_unlock(&devs[selectedDevice].lock);
+	return rows;
 }
 
 - (id)tableView:(NSTableView *)tableView
 objectValueForTableColumn:(NSTableColumn *)tableColumn
 			row:(int)row
 {
+	NSString *value = @"";
+	pthread_mutex_lock(&devs[selectedDevice].lock);
 	if( [[devs[selectedDevice].pmtSet getCaDescriptors] count] > row )
 	{
 		caDescriptor *desc = [[devs[selectedDevice].pmtSet getCaDescriptors] objectAtIndex:row];
 		NSString *column = [tableColumn identifier];
 		if( [column isEqualToString:@"caid"] )
 		{
-			return [NSString stringWithFormat:@"%04x", [desc getCasys]];
+			value = [NSString stringWithFormat:@"%04x", [desc getCasys]];
 		}
 		else if( [column isEqualToString:@"ident"] )
 		{
-			return [NSString stringWithFormat:@"%06x", [desc getIdent]];
+			value = [NSString stringWithFormat:@"%06x", [desc getIdent]];
 		}
 		else if( [column isEqualToString:@"ecmpid"] )
 		{
-			return [NSString stringWithFormat:@"%04x", [desc getEcmpid]];
+			value = [NSString stringWithFormat:@"%04x", [desc getEcmpid]];
 		}
 	}
-	return @"";
+	pthread_mutex_unlock(&devs[selectedDevice].lock);
+	return value;
 }
 
 - (void)irdetoChannelChange:(unsigned int)irdchn
 {
 	devCtrl *pDev = &devs[selectedDevice];
 	int row = [caDescList selectedRow];
+	pthread_mutex_lock(&pDev->lock);
 	int rowCount = [[pDev->pmtSet getCaDescriptors] count];
+	unsigned int msgid = (pDev->curPmtPid << 16) | (pDev->curServiceId & 0xffff);
+	pthread_mutex_unlock(&pDev->lock);
 	if( row == -1 || rowCount <= row ) 
 		return;
 	caDescriptor *ca = [[caDescriptor alloc] initStaticWithEcmpid:0 casys:0 ident:0];
-	unsigned int msgid = (pDev->curPmtPid << 16) | (pDev->curServiceId & 0xffff);
 	[ca setMessageId:msgid];
+	pthread_rwlock_wrlock(&caCacheLock);
 	caDescriptor *found = [caCache member:ca];
-	[ca release];
 	if( found != nil )
 	{
 		[found setIrdetoChannel:irdchn];
 	}
+	pthread_rwlock_unlock(&caCacheLock);
+	[ca release];
+	if( found != nil )
+	{
+		[self caSelectionChanged];
+	}
 }
 
 - (void)tableViewSelectionDidChange:(NSNotification *)notification
 {
-	int row = [caDescList selectedRow];
+	int devno = selectedDevice;
+	pthread_mutex_lock(&devs[devno].lock);
+	[self selectCaRow:[caDescList selectedRow]];
+	pthread_mutex_unlock(&devs[devno].lock);
+}
+
+// the user's choice of CA descriptor, under the device's lock
+- (void)selectCaRow:(int)row
+{
 	int rowCount = [[devs[selectedDevice].pmtSet getCaDescriptors] count];
 	if( row == -1 || rowCount <= row ) 
 		return;
@@ -651,7 +753,7 @@ objectValueForTableColumn:(NSTableColumn *)tableColumn
 	caDescriptor *desc = [[devs[selectedDevice].pmtSet getCaDescriptors] objectAtIndex:row];
 	if( desc != 0 )
 	{
-		devs[selectedDevice].curEcmPid = [desc getEcmpid];
+		setEcmPid(&devs[selectedDevice], [desc getEcmpid]);
 		msgPid filterPid;
 		filterPid.id = msg_add_pid;
 		filterPid.mPid = htonl(devs[selectedDevice].curEcmPid);
@@ -660,7 +762,7 @@ objectValueForTableColumn:(NSTableColumn *)tableColumn
 		[self sendData:pmsg dev:selectedDevice];
 		if( doCaChange == YES )
 		{
-			[devs[selectedDevice].sECM reset];
+			devs[selectedDevice].sECM.reset();
 			typeOnlyMessage ca;
 			ca.id = msg_ca_change;
 			[pmsg setLength:0];
@@ -671,6 +773,7 @@ objectValueForTableColumn:(NSTableColumn *)tableColumn
 																   casys:[desc getCasys] ident:[desc getIdent]];
 		int msgid = (devs[selectedDevice].curPmtPid << 16) | (devs[selectedDevice].curServiceId & 0xffff);
 		[cache setMessageId:msgid];
+		pthread_rwlock_wrlock(&caCacheLock);
 		caDescriptor *incache = [caCache member:cache];
 		if( incache == nil )
 		{
@@ -680,8 +783,10 @@ objectValueForTableColumn:(NSTableColumn *)tableColumn
 		{
 			[incache setEcmpid:[desc getEcmpid] casys:[desc getCasys] ident:[desc getIdent]];
 		}
+		pthread_rwlock_unlock(&caCacheLock);
 		[cache release];
 		[pmsg release];
+		[self caSelectionChanged];
 		devCtrl *pDev = &devs[selectedDevice];
 		unsigned int emmCaCount = [pDev->catSet caDescCount];
 		if( emmCaCount != 0 && ( [prevDesc getCasys] != [desc getCasys] ) )
@@ -734,6 +839,102 @@ objectValueForTableColumn:(NSTableColumn *)tableColumn
 	[pool release];
 }
 
+/* The plugin's packets come through the shared memory rings of tsring.h, one
+ * per device, each drained by a thread of its own. It decodes what it took
+ * under the device's lock, so PMT parsing, ECMs and EMMs of one device
+ * don't wait for those of another. */
+
+- (void)ringThreadStart:(NSNumber *)dev
+{
+	NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+	[self drainRing:[dev intValue]];
+	[pool release];
+}
+
+- (void)drainRing:(int)idx
+{
+	tsring *r = &rings[idx];
+	tsringSlot slots[TS_BATCH_MAX];
+	unsigned char *pkts[TS_BATCH_MAX];
+	for( int n = 0; n < TS_BATCH_MAX; n++ )
+	{
+		pkts[n] = slots[n].data;
+	}
+	while( 1 )
+	{
+		int count = 0;
+		while( count < TS_BATCH_MAX && tsringPop(r, &slots[count]) == true )
+		{
+			count++;
+		}
+		if( count == 0 )
+		{
+			if( tsringArmWakeup(r) == true )
+			{
+				sem_wait(r->wake);
+			}
+			tsringDisarmWakeup(r);
+			continue;
+		}
+		NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+		pthread_mutex_lock(&devs[idx].lock);
+		[self decodeRingBatch:pkts count:count dev:idx];
+		pthread_mutex_unlock(&devs[idx].lock);
+		[pool release];
+	}
+}
+
+/* A device's packets are classified TS_BATCH_MAX at a time and decoded PID
+ * by PID. Where messages are among them, which may change what a PID is
+ * for, everything goes in the order it came. */
+- (void)decodeRingBatch:(unsigned char **)pkts count:(int)count dev:(int)idx
+{
+	tsBatch ts;
+	tsClassify(&ts, pkts, count);
+	if( ts.unsynced != 0 )
+	{
+		for( int k = 0; k < count; k++ )
+		{
+			if( ts.info[k].flags & TS_SYNC )
+			{
+				uint16_t index = k;
+				[self decodePid:ts.info[k].pid packets:pkts info:ts.info index:&index count:1 dev:idx];
+			}
+			else
+			{
+				[self decodePluginPacket:pkts[k] dev:idx];
+			}
+		}
+	}
+	else
+	{
+		for( int g = 0; g < ts.pidCount; g++ )
+		{
+			[self decodePid:ts.pid[g] packets:pkts info:ts.info index:&ts.index[ts.first[g]] 
+				  count:ts.first[g + 1] - ts.first[g] dev:idx];
+		}
+	}
+}
+
+// the device's CA list, after its thread changed it
+- (void)showDevice:(NSNumber *)dev
+{
+	int idx = [dev intValue];
+	pthread_mutex_lock(&devs[idx].lock);
+	if( selectedDevice == idx )
+	{
+		[caDescList reloadData];
+		int row = devs[idx].selected;
+		if( row != -1 && row < [devs[idx].pmtSet caDescCount] )
+		{
+			pmtChanged = YES;
+			[caDescList selectRowIndexes:[NSIndexSet indexSetWithIndex:row] byExtendingSelection:NO]; 
+			pmtChanged = NO;
+		}
+	}
+	pthread_mutex_unlock(&devs[idx].lock);
+}
+
 - (void)sendData:(NSData *)pdata dev:(int)devIndex
 {
 #if defined(USE_NSPORT_IPC)
@@ -781,6 +982,9 @@ objectValueForTableColumn:(NSTableColumn *)tableColumn
 		//    }
 		//    else break;
 		
+		// called from the network on the main thread and from the emulation on
+		// any device's thread, which holds its own device lock
+		pthread_mutex_lock(&devs[i].cwLock);
 		if( sid == devs[i].curServiceId && [devs[i].curCa isEqual:ca] == YES )
 		{
 			/*
@@ -805,31 +1009,44 @@ objectValueForTableColumn:(NSTableColumn *)tableColumn
 				dw[15] = dw[12] + dw[13] + dw[14];
 			}
 			[pmsg appendBytes:dw length:16];
+			unsigned long service = htonl(sid);
+			[pmsg appendBytes:&service length:sizeof(service)];
+			// the plugin polls the slot from its packet thread, the message
+			// only matters when it can't
+			if( cwSlots[i].shm != NULL )
+			{
+				cwSlotWrite(&cwSlots[i], dw, sid);
+			}
 			[self sendData:pmsg dev:i];
 			[pmsg release];
 		}
+		pthread_mutex_unlock(&devs[i].cwLock);
 	}
 }
 
 - (void)emmAddParams:(unsigned char *)serial provData:(unsigned char *)bytes caid:(unsigned int)casys ident:(unsigned int)provid
 {
 	emmParams *emmp = [[emmParams alloc] initWithSerial:serial provData:bytes caid:casys ident:provid];
+	pthread_rwlock_wrlock(&emmReadersLock);
 	emmParams *reader = [emmReaders member:emmp];
 	if( reader == nil )
 	{
 		[emmReaders addObject:emmp];
 	}
+	pthread_rwlock_unlock(&emmReadersLock);
 	[emmp release];
 }
 
 - (void)emmRmParams:(unsigned char *)serial provData:(unsigned char *)bytes caid:(unsigned int)casys ident:(unsigned int)provid
 {
 	emmParams *emmp = [[emmParams alloc] initWithSerial:serial provData:bytes caid:casys ident:provid];
+	pthread_rwlock_wrlock(&emmReadersLock);
 	emmParams *reader = [emmReaders member:emmp];
 	if( reader != nil )
 	{
 		[emmReaders removeObject:reader];
 	}
+	pthread_rwlock_unlock(&emmReadersLock);
 	[emmp release];
 }
 
@@ -839,6 +1056,7 @@ objectValueForTableColumn:(NSTableColumn *)tableColumn
 	int newIndex =  [sender indexOfSelectedItem] - 1;
 	[sender setTitle:[NSString stringWithFormat:@"device %d", newIndex]];
 	[irdCtl setSelectedDevice:newIndex];
+	pthread_mutex_lock(&devs[newIndex].lock);
 	int newca = devs[newIndex].selected;
 	if ( selectedDevice != newIndex )
 	{
@@ -849,6 +1067,7 @@ objectValueForTableColumn:(NSTableColumn *)tableColumn
 			[caDescList selectRowIndexes:[NSIndexSet indexSetWithIndex:newca] byExtendingSelection:NO]; 
 		}
 	}
+	pthread_mutex_unlock(&devs[newIndex].lock);
 	doCaChange = YES;
 }
 
@@ -879,7 +1098,9 @@ objectValueForTableColumn:(NSTableColumn *)tableColumn
 	else
 	{
 		[sender setTitle:@"Start ECM & EMM rec"];
+		pthread_mutex_lock(&recordLock);
 		[recordPids removeAllObjects];
+		pthread_mutex_unlock(&recordLock);
 	}
 	setRawRecording(action);
 }
@@ -998,16 +1219,38 @@ objectValueForTableColumn:(NSTableColumn *)tableColumn
 
 - (void)clearAllEmm:(int)devno
 {
-	[devs[devno].emmSectionFilter removeAllObjects];
-	[devs[devno].emmBuffer removeAllObjects];
-	[devs[devno].emmState removeAllObjects];
+	devCtrl *pDev = &devs[devno];
+	for( int i = 0; i < pDev->emmCount; i++ )
+	{
+		pDev->pids[pDev->emmPids[i].pid % NUM_PIDS].role &= ~PID_EMM;
+		[pDev->emmPids[i].buffer release];
+		pDev->emmPids[i].buffer = nil;
+	}
+	pDev->emmCount = 0;
 }
 
 - (void)startAllEmmPids
 {
 	for( int i = 0; i < NUM_DEVS; i++ )
 	{
-		[devs[i].sCAT reset];
+		pthread_mutex_lock(&devs[i].lock);
+		devs[i].sCAT.reset();
+		devs[i].vCAT.reset();
+		pthread_mutex_unlock(&devs[i].lock);
+	}
+}
+
+/* The CA descriptor a device takes from its PMT depends on caCache and on
+ * the servers, their enabled state and CAID filters (hasCasys). Whoever
+ * changes those calls this, from any thread; every device then parses its
+ * next PMT again. */
+- (void)caSelectionChanged
+{
+	for( int i = 0; i < NUM_DEVS; i++ )
+	{
+		pthread_mutex_lock(&devs[i].lock);
+		devs[i].vPMT.reset();
+		pthread_mutex_unlock(&devs[i].lock);
 	}
 }
 
@@ -1016,39 +1259,70 @@ objectValueForTableColumn:(NSTableColumn *)tableColumn
 	for( int i = 0; i < NUM_DEVS; i++ )
 	{
 		devCtrl *pDev = &devs[i];
-		if( [pDev->emmSectionFilter count] != 0 )
+		pthread_mutex_lock(&pDev->lock);
+		for( int n = 0; n < pDev->emmCount; n++ )
 		{
-			NSEnumerator *emms = [pDev->emmSectionFilter objectEnumerator];
-			section *sEmm;
-			while ( (sEmm = [emms nextObject]) != nil )
-			{
-				unsigned long emmPid = [sEmm getPid];
-				msgPid filterPid;
-				filterPid.id = msg_remove_pid;
-				filterPid.mPid = htonl(emmPid);
-				NSMutableData *pmsg = [[NSMutableData alloc] init];
-				[pmsg appendBytes:&filterPid length:sizeof(filterPid)];
-				[self sendData:pmsg dev:i];
-				ControllerLog("EMM Processing: stop emmpid:%x\n", emmPid);
-			}
+			unsigned long emmPid = pDev->emmPids[n].pid;
+			msgPid filterPid;
+			filterPid.id = msg_remove_pid;
+			filterPid.mPid = htonl(emmPid);
+			NSMutableData *pmsg = [[NSMutableData alloc] init];
+			[pmsg appendBytes:&filterPid length:sizeof(filterPid)];
+			[self sendData:pmsg dev:i];
+			ControllerLog("EMM Processing: stop emmpid:%x\n", emmPid);
 		}
+		pthread_mutex_unlock(&pDev->lock);
+	}
+}
+
+// one file per PID in the record directory, opened with its first section
+- (void)recordSection:(const unsigned char *)data length:(unsigned int)len name:(NSString *)key
+{
+	pthread_mutex_lock(&recordLock);
+	BOOL fileRelease = NO;
+	NSOutputStream *file = [recordPids objectForKey:key];
+	if( file == 0 )
+	{
+		NSString *path = [[[docPath stringByExpandingTildeInPath] stringByAppendingPathComponent:@"record"] 
+						  stringByAppendingPathComponent:key];
+		file = [[NSOutputStream alloc] initToFileAtPath:path append:YES];
+		[file open];
+		[recordPids setObject:file forKey:key];
+		fileRelease = YES;
+	}
+	[file write:data maxLength:len];
+	if( fileRelease == YES )
+	{
+		[file release];
 	}
+	pthread_mutex_unlock(&recordLock);
 }
 
 - (void)addEmmPid:(unsigned int)pid toDevice:(int)devno
 {
 	devCtrl *pDev = &devs[devno];
-	NSNumber *key = [[NSNumber alloc] initWithUnsignedInt:pid];
-	NSNumber *state = [[NSNumber alloc] initWithInt:(int)emmStateNone];
-	NSMutableData *buffer = [[NSMutableData alloc] initWithCapacity:1024];
-	section *sEmm = [[section alloc] initWithPid:pid];
-	[pDev->emmSectionFilter setObject:sEmm forKey:key];
-	[pDev->emmBuffer setObject:buffer forKey:key];
-	[pDev->emmState setObject:state forKey:key];
-	[sEmm release];
-	[buffer release];
-	[state release];
-	[key release];
+	pidEntry *route = &pDev->pids[pid % NUM_PIDS];
+	emmPidCtrl *pEmmPid;
+	if( route->role & PID_EMM )
+	{
+		pEmmPid = &pDev->emmPids[route->emm];   // again, starts over
+	}
+	else
+	{
+		if( pDev->emmCount == NUM_EMM_PIDS )
+		{
+			ControllerLog("EMM Processing: too many emm pids (%d), %x ignored\n", NUM_EMM_PIDS, pid);
+			return;
+		}
+		route->emm = pDev->emmCount++;
+		route->role |= PID_EMM;
+		pEmmPid = &pDev->emmPids[route->emm];
+		pEmmPid->buffer = [[NSMutableData alloc] initWithCapacity:1024];
+	}
+	pEmmPid->pid = pid;
+	pEmmPid->state = emmStateNone;
+	[pEmmPid->buffer setLength:0];
+	pEmmPid->filter.init(pid);
 }
 
 - (id) init 
@@ -1070,6 +1344,12 @@ objectValueForTableColumn:(NSTableColumn *)tableColumn
 		cacacheFile = [[NSString alloc] initWithCString:"cacache.plist"];
 		configFile = [[NSString alloc] initWithCString:"gcfg.plist"];
 		recordPids = [[NSMutableDictionary alloc] init];
+		pthread_rwlock_init(&caCacheLock, NULL);
+		pthread_rwlock_init(&emmReadersLock, NULL);
+		pthread_mutex_init(&recordLock, NULL);
+		pthread_mutexattr_t recursive;
+		pthread_mutexattr_init(&recursive);
+		pthread_mutexattr_settype(&recursive, PTHREAD_MUTEX_RECURSIVE);
 		NSArray *file = [[NSArray alloc] initWithContentsOfFile:[[docPath stringByExpandingTildeInPath]
 																 stringByAppendingPathComponent:cacacheFile]];
 		{
@@ -1091,24 +1371,28 @@ objectValueForTableColumn:(NSTableColumn *)tableColumn
 		}
 		for(int i = 0; i < NUM_DEVS; i++)
 		{
-			devs[i].sPMT = [[section alloc] initWithPid:0];
-			devs[i].sECM = [[section alloc] initWithPid:0];
-			devs[i].sCAT = [[section alloc] initWithPid:0];
-			//      devs[i].sEMM = [[section alloc] initWithPid:0];
+			pthread_mutex_init(&devs[i].lock, &recursive);
+			pthread_mutex_init(&devs[i].cwLock, NULL);
+			devs[i].sPMT.init(0);
+			devs[i].sECM.init(0);
+			devs[i].sCAT.init(0);
+			devs[i].vPMT.reset();
+			devs[i].vCAT.reset();
 			devs[i].curTransponderId = 0;
 			devs[i].curServiceId = 0;
 			devs[i].curPmtPid = 0;
 			devs[i].curEcmPid = 0;
+			memset(devs[i].pids, 0, sizeof(devs[i].pids));
+			devs[i].pids[0].role = PID_PMT | PID_ECM;   // curPmtPid and curEcmPid
+			devs[i].pids[1].role = PID_CAT;             // the CAT PID is always 1
+			devs[i].emmCount = 0;
+			devs[i].pmtRetry = 0;
 			devs[i].pmtSet = [[pmt alloc] init];
 			devs[i].catSet = [[cat alloc] init];
 			devs[i].selected = -1;
 			devs[i].curCa = [[caDescriptor alloc] initStaticWithEcmpid:0 casys:0 ident:0];
-			//      devs[i].emmBufferState = emmStateNone;
-			//      devs[i].emmBuffer = [[NSMutableData alloc] initWithCapacity:1024];
-			devs[i].emmSectionFilter = [[NSMutableDictionary alloc] init];
-			devs[i].emmBuffer = [[NSMutableDictionary alloc] init];
-			devs[i].emmState = [[NSMutableDictionary alloc] init];
 		}
+		pthread_mutexattr_destroy(&recursive);
 		NSString *teststr = [[NSString alloc] initWithCString:"test"];
 		NSFileManager *dir = [NSFileManager defaultManager];
 		NSString *path = [[docPath stringByExpandingTildeInPath] stringByAppendingPathComponent:@".tstfile"];
@@ -1147,18 +1431,16 @@ objectValueForTableColumn:(NSTableColumn *)tableColumn
 	[recordPids release];
 	for(int i = 0; i < NUM_DEVS; i++)
 	{
-		[devs[i].sPMT release];
-		[devs[i].sECM release];
-		[devs[i].sCAT release];
-		//    [devs[i].sEMM release];
 		[devs[i].pmtSet release];
 		[devs[i].catSet release];
 		[devs[i].curCa release];
-		//    [devs[i].emmBuffer release];
-		[devs[i].emmSectionFilter release];
-		[devs[i].emmBuffer release];
-		[devs[i].emmState release];
+		[self clearAllEmm:i];
+		pthread_mutex_destroy(&devs[i].lock);
+		pthread_mutex_destroy(&devs[i].cwLock);
 	}
+	pthread_rwlock_destroy(&caCacheLock);
+	pthread_rwlock_destroy(&emmReadersLock);
+	pthread_mutex_destroy(&recordLock);
 	[dumpLocker release];
 	[logLocker release];
 	[super dealloc];
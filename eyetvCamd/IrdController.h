@@ -29,6 +29,7 @@ typedef struct
 }
 
 - (void) clearValid:(unsigned int)index;
+- (void) showChannels:(id)obj;
 - (void) setSelectedDevice:(unsigned int)index;
 - (void) clear:(unsigned int)devIndex;
 - (NSData *) getEcm:(NSData *)Packet dev:(unsigned int)devIndex;
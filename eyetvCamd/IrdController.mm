@@ -55,8 +55,17 @@
   devs[index].validFlag = NO;
   if(index == selectedDevice)
   {
-    [chanView reloadData];
-//    [chanView selectRowIndexes:[NSIndexSet indexSetWithIndex:devs[index].curSelectedIndex] byExtendingSelection:NO];
+    [self performSelectorOnMainThread:@selector(showChannels:) withObject:nil waitUntilDone:NO];
+  }
+}
+
+// clearValid and getEcm run on the device's thread, the view is the main thread's
+- (void) showChannels:(id)obj
+{
+  [chanView reloadData];
+  if( devs[selectedDevice].validFlag == YES )
+  {
+    [chanView selectRowIndexes:[NSIndexSet indexSetWithIndex:devs[selectedDevice].curSelectedIndex] byExtendingSelection:NO];
   }
 }
 
@@ -116,8 +125,7 @@
 	  pDev->validFlag = YES;
 	  if( devIndex == selectedDevice )
 	  {
-	    [chanView reloadData];
-	    [chanView selectRowIndexes:[NSIndexSet indexSetWithIndex:pDev->curSelectedIndex] byExtendingSelection:NO];
+	    [self performSelectorOnMainThread:@selector(showChannels:) withObject:nil waitUntilDone:NO];
 	  }
 	}
 	return pDev->irdEcm[pDev->curSelectedIndex];
@@ -4,6 +4,7 @@
 #import "pmt.h"
 #import "IrdController.h"
 #import "emm.h"
+#include <pthread.h>
 
 @interface SrvController : NSObject
 {
@@ -13,6 +14,7 @@
     IBOutlet NSButton *emuBtn;
     NSMutableArray *dSource;
     NSMutableArray *csList;
+    pthread_rwlock_t csListLock;  // csList and its filters, see hasCasys
     id delegateObj;
     NSString *docPath;
     NSString *serversFile;
@@ -30,9 +32,12 @@
 - (bool)hasCasys:(unsigned int)Casys Ident:(unsigned int)Ident;
 - (void)sendEcmPacket:(NSData *)Packet Cadesc:(caDescriptor *)desc Ssid:(unsigned int)ssid devIndex:(unsigned int)index;
 - (void)sendEmmPacket:(NSData *)Packet Params:(emmParams *)params;
+- (void)sendEcmToServers:(NSArray *)args;
+- (void)sendEmmToServers:(NSArray *)args;
 - (void)writeDwToDescrambler:(unsigned char *)dw caDesc:(caDescriptor *)ca sid:(unsigned long)sid;
 - (void)emmAddParams:(unsigned char *)serial provData:(unsigned char *)bytes caid:(unsigned int)casys ident:(unsigned int)provid;
 - (void)emmRmParams:(unsigned char *)serial provData:(unsigned char *)bytes caid:(unsigned int)casys ident:(unsigned int)provid;
+- (void)caSelectionChanged;
 - (void)setDelegateForController:(id)obj;
 - (void)initEmu;
 - (void)loadServerConfigAndCache;
@@ -28,10 +28,13 @@
   uniproto *obj = [[uniproto alloc] initWithProto:@"camd3" User:@"" Password:@"" Host:@"" Port:@"" NcdKey:@""];
   uniproto *srv = [[camd3Client alloc] initWithProto:@"camd3" User:@"" Password:@"" Host:@"" Port:@"" NcdKey:@""]; 
   [dSource addObject:obj];
+  pthread_rwlock_wrlock(&csListLock);
   [csList addObject:srv];
+  pthread_rwlock_unlock(&csListLock);
   [obj release];
   [srv release];
   [srvListView reloadData];
+  [self caSelectionChanged];
 }
 
 - (IBAction)removeFilterForServer:(id)sender
@@ -43,8 +46,11 @@
     uniproto *obj = [dSource objectAtIndex:srvrow];
     uniproto *server = [csList objectAtIndex:srvrow];
     [obj removeFilterAtIndex:fltrow];
+    pthread_rwlock_wrlock(&csListLock);
     [server removeFilterAtIndex:fltrow];
+    pthread_rwlock_unlock(&csListLock);
     [filerListView reloadData];
+    [self caSelectionChanged];
   }
 }
 
@@ -53,9 +59,12 @@
   int srvrow = [srvListView selectedRow];
   if( srvrow != -1 )
   {
+    pthread_rwlock_wrlock(&csListLock);
     [csList removeObjectAtIndex:srvrow];
+    pthread_rwlock_unlock(&csListLock);
     [dSource removeObjectAtIndex:srvrow];
     [srvListView reloadData];
+    [self caSelectionChanged];
   }
 }
 
@@ -284,12 +293,15 @@
 	    [srv addFilterEntry:[obj getFilterEntryAtIndex:i]];
 	  }
 	  [srv setDelegate:self];
+	  pthread_rwlock_wrlock(&csListLock);
 	  [csList replaceObjectAtIndex:row withObject:srv];
+	  pthread_rwlock_unlock(&csListLock);
 	  [srv release];
 	}
       }
       [obj enable:doEnable];
       [[csList objectAtIndex:row] enable:doEnable];
+      [self caSelectionChanged];
     }
   }
   if( tableView == filerListView && row != -1 )
@@ -312,6 +324,7 @@
       }
       if( memcmp([obj getFilterSignature], [server getFilterSignature], 16) != 0 )
       {
+	pthread_rwlock_wrlock(&csListLock);
 	for(int i = 0; i < [server getFilterCount]; i++)
 	{
 	  [server removeFilterAtIndex:i];
@@ -320,6 +333,8 @@
 	{
 	  [server addFilterEntry:[obj getFilterEntryAtIndex:i]];
 	}
+	pthread_rwlock_unlock(&csListLock);
+	[self caSelectionChanged];
       }
     }
   }
@@ -346,6 +361,15 @@
   }
 }
 
+// what hasCasys answers changed, the devices choose their CA descriptors again
+- (void)caSelectionChanged
+{
+  if ([delegateObj respondsToSelector:@selector(caSelectionChanged)])
+  {
+    [delegateObj caSelectionChanged];
+  }
+}
+
 - (void)emmAddParams:(unsigned char *)serial provData:(unsigned char *)bytes caid:(unsigned int)casys ident:(unsigned int)provid
 {
   if ([delegateObj respondsToSelector:@selector(emmAddParams:provData:caid:ident:)])
@@ -406,19 +430,28 @@
   [srvListView registerForDraggedTypes: [NSArray arrayWithObjects: NSStringPboardType, nil]];
 }
 
+/* The device threads look at the server list and the filters, the main
+ * thread changes them under the write lock and reads them without. The
+ * clients themselves, their sockets, timers and request lists, belong to
+ * the main thread's run loop: packets are sent to them from there. */
+
 - (bool)hasCasys:(unsigned int)Casys Ident:(unsigned int)Ident
 {
+  bool found = false;
+  pthread_rwlock_rdlock(&csListLock);
   NSEnumerator *iter = [csList objectEnumerator];
   id sender;
   while( sender = [iter nextObject] )
   {
     if( [sender isEnabled] == YES && [sender isAllowdCaid:Casys Ident:Ident] == YES)
     {
-	  return true;
+	  found = true;
+	  break;
     }
   }
+  pthread_rwlock_unlock(&csListLock);
   
-  return false;
+  return found;
 }
 
 - (void)sendEcmPacket:(NSData *)Packet Cadesc:(caDescriptor *)desc Ssid:(unsigned int)ssid  devIndex:(unsigned int)index
@@ -448,14 +481,15 @@
     }
   }
 
-  NSEnumerator *iter = [csList objectEnumerator];
-  id sender;
-  while( sender = [iter nextObject] )
+  if( ecmPacket != nil )
   {
-    if( [sender isEnabled] == YES && [sender isAllowdCaid:[desc getCasys] Ident:[desc getIdent]] == YES)
-    {
-      if( ecmPacket != nil ) [sender sendEcmPacket:ecmPacket Cadesc:desc Ssid:ssid devIndex:index];
-    }
+    // the descriptor is the device's and changes with it, the clients get a copy
+    caDescriptor *ca = [[caDescriptor alloc] initStaticWithEcmpid:[desc getEcmpid] casys:[desc getCasys] ident:[desc getIdent]];
+    NSArray *args = [[NSArray alloc] initWithObjects:ecmPacket, ca, [NSNumber numberWithUnsignedInt:ssid], 
+					       [NSNumber numberWithUnsignedInt:index], nil];
+    [self performSelectorOnMainThread:@selector(sendEcmToServers:) withObject:args waitUntilDone:NO];
+    [args release];
+    [ca release];
   }
 
 	if( ecmPacket != nil && enableEmu == YES )
@@ -487,8 +521,37 @@
 	}
 }
 
+- (void)sendEcmToServers:(NSArray *)args
+{
+  NSData *ecmPacket = [args objectAtIndex:0];
+  caDescriptor *desc = [args objectAtIndex:1];
+  unsigned int ssid = [[args objectAtIndex:2] unsignedIntValue];
+  unsigned int index = [[args objectAtIndex:3] unsignedIntValue];
+  NSEnumerator *iter = [csList objectEnumerator];
+  id sender;
+  while( sender = [iter nextObject] )
+  {
+    if( [sender isEnabled] == YES && [sender isAllowdCaid:[desc getCasys] Ident:[desc getIdent]] == YES)
+    {
+      [sender sendEcmPacket:ecmPacket Cadesc:desc Ssid:ssid devIndex:index];
+    }
+  }
+}
+
 - (void)sendEmmPacket:(NSData *)Packet Params:(emmParams *)params
 {
+  // Packet may be the device's assembly buffer, which is reused
+  NSData *emm = [[NSData alloc] initWithData:Packet];
+  NSArray *args = [[NSArray alloc] initWithObjects:emm, params, nil];
+  [self performSelectorOnMainThread:@selector(sendEmmToServers:) withObject:args waitUntilDone:NO];
+  [args release];
+  [emm release];
+}
+
+- (void)sendEmmToServers:(NSArray *)args
+{
+  NSData *Packet = [args objectAtIndex:0];
+  emmParams *params = [args objectAtIndex:1];
   NSEnumerator *iter = [csList objectEnumerator];
   id sender;
   while( sender = [iter nextObject] )
@@ -575,12 +638,15 @@
 	}
 	[srv enable:doEnable];
 	[srv setDelegate:self];
+	pthread_rwlock_wrlock(&csListLock);
 	[csList addObject:srv];
+	pthread_rwlock_unlock(&csListLock);
 	[srv release];
       }
       [uobj release];
     }
     [file release];
+    [self caSelectionChanged];
   }
 }
 
@@ -591,6 +657,7 @@
   {
     dSource = [[NSMutableArray alloc] init];
     csList = [[NSMutableArray alloc] init];
+    pthread_rwlock_init(&csListLock, NULL);
     docPath = [[NSString alloc] initWithCString:"~/Documents/eyetvCamd"];
     serversFile = [[NSString alloc] initWithCString:"servers.plist"];
     cacacheFile = [[NSString alloc] initWithCString:"cacache.plist"];
@@ -625,6 +692,7 @@
   [dSource removeAllObjects];
   [dSource release];
   [csList release];
+  pthread_rwlock_destroy(&csListLock);
   [super dealloc];
 }
 
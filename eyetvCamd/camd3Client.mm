@@ -3,8 +3,7 @@
 #import "pmt.h"
 #include <openssl/md5.h>
 #include "globals.h"
-
-extern "C" unsigned long crc32(unsigned long, void *, unsigned int );
+#include "crc32.h"
 
 @implementation camd3Client
 
@@ -0,0 +1,37 @@
+#if !defined(__CRC32_H__)
+#define __CRC32_H__
+
+/* CRC-32, both bit orders.
+ *
+ * crc32 is zlib's CRC-32 (reflected polynomial 0xedb88320), as used for the
+ * descriptor and parameter hashes, the camd3 packets and the message caches:
+ * start with 0, feed the result of one call into the next.
+ *
+ * crc32Mpeg is the CRC-32 of MPEG-2 PSI sections (ISO 13818-1 annex A,
+ * polynomial 0x04c11db7, msb first, no final inversion): start with
+ * 0xffffffff. Over a whole section, its CRC_32 included, it is 0 for an
+ * intact section, see crc32SectionValid.
+ *
+ * Both run 8 bytes per step from compile time tables (slicing-by-8);
+ * crc32 folds longer buffers with PCLMULQDQ where the cpu has it. */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+unsigned long crc32(unsigned long crc, const void *buf, unsigned int len);
+uint32_t crc32Mpeg(uint32_t crc, const void *buf, unsigned int len);
+
+#ifdef __cplusplus
+}
+#endif
+
+// a PSI section with section_syntax_indicator set, its CRC_32 last
+static inline int crc32SectionValid(const unsigned char *section, unsigned int len)
+{
+  return len >= 4 && crc32Mpeg(0xffffffff, section, len) == 0;
+}
+
+#endif
@@ -0,0 +1,216 @@
+/* crc32_bench.c -- throughput of the CRC-32 paths of crc32.c
+ *
+ * Not part of the daemon, build it on linux with
+ *
+ *   cc -O2 -c -mpclmul crc32_pclmul.c
+ *   cc -O2 -o crc32_bench crc32_bench.c crc32_pclmul.o
+ *
+ * (crc32_pclmul.c only on x86; without -mpclmul it is a stub and only
+ * slicing-by-8 runs). It includes crc32.c to switch the PCLMULQDQ path off
+ * and on, checks every path against a bit at a time loop of each
+ * polynomial, which doesn't use the tables, over all lengths up to 5000 at
+ * alignments 0 to 7, then prints for the buffer sizes the daemon sees
+ * (descriptor hashes, ECMs, sections)
+ *   MB/s      bytes per second
+ *   ns/call   time per call
+ * for the bytewise reference, slicing-by-8 and PCLMULQDQ, and the same
+ * for the MPEG-2 CRC. Run it with -t seconds to change the measuring time
+ * per line (0.5).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+
+#include "crc32.c"
+
+#define VERIFY_LEN 5000
+
+static double now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* the references: one bit per step, straight from the polynomials */
+static unsigned long crc32_bitwise(unsigned long crc, const void *buf, unsigned int len)
+{
+  const unsigned char *p = (const unsigned char *)buf;
+  uint32_t c = (uint32_t)crc ^ 0xffffffffUL;
+  int k;
+  while (len--)
+  {
+    c ^= *p++;
+    for (k = 0; k < 8; k++)
+      c = c & 1 ? (c >> 1) ^ 0xedb88320UL : c >> 1;
+  }
+  return c ^ 0xffffffffUL;
+}
+
+static uint32_t crc32Mpeg_bitwise(uint32_t crc, const void *buf, unsigned int len)
+{
+  const unsigned char *p = (const unsigned char *)buf;
+  int k;
+  while (len--)
+  {
+    crc ^= (uint32_t)*p++ << 24;
+    for (k = 0; k < 8; k++)
+      crc = crc & 0x80000000UL ? (crc << 1) ^ 0x04c11db7UL : crc << 1;
+  }
+  return crc;
+}
+
+/* crc32.c before slicing, and libsi's MPEG-2 loop, for the speed only */
+static unsigned long crc32_bytewise(unsigned long crc, const void *buf, unsigned int len)
+{
+  const unsigned char *p = (const unsigned char *)buf;
+  uint32_t c = (uint32_t)crc ^ 0xffffffffUL;
+  while (len--)
+    c = crc_table[0][(c ^ *p++) & 0xff] ^ (c >> 8);
+  return c ^ 0xffffffffUL;
+}
+
+static uint32_t crc32Mpeg_bytewise(uint32_t crc, const void *buf, unsigned int len)
+{
+  const unsigned char *p = (const unsigned char *)buf;
+  while (len--)
+    crc = (crc << 8) ^ crc_mpeg_table[0][(crc >> 24) ^ *p++];
+  return crc;
+}
+
+static int have_pclmul(void)
+{
+#ifdef CRC32_X86
+  crc32_select();
+  return crc_pclmul;
+#else
+  return 0;
+#endif
+}
+
+static const char *pclmul_missing(void)
+{
+#ifdef CRC32_X86
+  if (!crc32_pclmul_built)
+    return " (pclmulqdq not built, see crc32_pclmul.c)";
+#endif
+  return " (no pclmulqdq on this cpu)";
+}
+
+static void use_pclmul(int on)
+{
+#ifdef CRC32_X86
+  crc_pclmul = on;
+#endif
+}
+
+static int verify(const unsigned char *buf)
+{
+  unsigned int len, off;
+  int bad = 0;
+
+  for (off = 0; off < 8; off++)
+    for (len = 0; len <= VERIFY_LEN; len++)
+    {
+      if (crc32(0x12345678, buf + off, len) != crc32_bitwise(0x12345678, buf + off, len))
+        bad++;
+      if (crc32Mpeg(0xffffffff, buf + off, len) != crc32Mpeg_bitwise(0xffffffff, buf + off, len))
+        bad++;
+    }
+  return bad;
+}
+
+static volatile uint32_t sink;
+
+static void measure(const char *name, int mpeg, int bytewise, const unsigned char *buf, unsigned int len, double seconds)
+{
+  double start = now(), elapsed;
+  long calls = 0;
+  uint32_t c = 0;
+  int i;
+
+  do
+  {
+    for (i = 0; i < 1000; i++)
+    {
+      if (mpeg)
+        c ^= bytewise ? crc32Mpeg_bytewise(0xffffffff, buf, len) : crc32Mpeg(0xffffffff, buf, len);
+      else
+        c ^= (uint32_t)(bytewise ? crc32_bytewise(c, buf, len) : crc32(c, buf, len));
+    }
+    calls += 1000;
+    elapsed = now() - start;
+  } while (elapsed < seconds);
+  sink = c;
+  printf("%-14s %6u %10.1f %10.1f\n", name, len, calls * (double)len / elapsed / 1e6, elapsed / calls * 1e9);
+}
+
+int main(int argc, char **argv)
+{
+  static const unsigned int sizes[] = { 4, 16, 64, 188, 256, 1024, 4096 };
+  unsigned char *buf;
+  double seconds = 0.5;
+  unsigned int i;
+  int c, pclmul;
+
+  while ((c = getopt(argc, argv, "t:h")) != -1)
+  {
+    switch (c)
+    {
+      case 't': seconds = atof(optarg); break;
+      default:
+        fprintf(stderr, "usage: %s [-t seconds]\n", argv[0]);
+        return 1;
+    }
+  }
+
+  buf = (unsigned char *)malloc(VERIFY_LEN + 8);
+  if (buf == NULL)
+  {
+    fprintf(stderr, "out of memory\n");
+    return 1;
+  }
+  srand(0x47);
+  for (i = 0; i < VERIFY_LEN + 8; i++)
+    buf[i] = rand();
+
+  pclmul = have_pclmul();
+  use_pclmul(0);
+  if (verify(buf) != 0)
+  {
+    printf("slicing-by-8 differs from the bitwise reference\n");
+    return 1;
+  }
+  if (pclmul)
+  {
+    use_pclmul(1);
+    if (verify(buf) != 0)
+    {
+      printf("pclmulqdq differs from the bitwise reference\n");
+      return 1;
+    }
+  }
+  printf("all paths agree with the bitwise reference%s\n", pclmul ? "" : pclmul_missing());
+
+  printf("%-14s %6s %10s %10s\n", "crc", "bytes", "MB/s", "ns/call");
+  for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+  {
+    measure("zlib bytewise", 0, 1, buf, sizes[i], seconds);
+    use_pclmul(0);
+    measure("zlib slice-8", 0, 0, buf, sizes[i], seconds);
+    if (pclmul)
+    {
+      use_pclmul(1);
+      measure("zlib pclmul", 0, 0, buf, sizes[i], seconds);
+    }
+  }
+  for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+  {
+    measure("mpeg bytewise", 1, 1, buf, sizes[i], seconds);
+    measure("mpeg slice-8", 1, 0, buf, sizes[i], seconds);
+  }
+  free(buf);
+  return 0;
+}
@@ -0,0 +1,871 @@
+/* crc32tab.h -- tables for crc32.c, made by its MAKECRCH build */
+
+static const uint32_t crc_table[8][256] = {
+  {
+    0x00000000UL, 0x77073096UL, 0xee0e612cUL, 0x990951baUL, 0x076dc419UL,
+    0x706af48fUL, 0xe963a535UL, 0x9e6495a3UL, 0x0edb8832UL, 0x79dcb8a4UL,
+    0xe0d5e91eUL, 0x97d2d988UL, 0x09b64c2bUL, 0x7eb17cbdUL, 0xe7b82d07UL,
+    0x90bf1d91UL, 0x1db71064UL, 0x6ab020f2UL, 0xf3b97148UL, 0x84be41deUL,
+    0x1adad47dUL, 0x6ddde4ebUL, 0xf4d4b551UL, 0x83d385c7UL, 0x136c9856UL,
+    0x646ba8c0UL, 0xfd62f97aUL, 0x8a65c9ecUL, 0x14015c4fUL, 0x63066cd9UL,
+    0xfa0f3d63UL, 0x8d080df5UL, 0x3b6e20c8UL, 0x4c69105eUL, 0xd56041e4UL,
+    0xa2677172UL, 0x3c03e4d1UL, 0x4b04d447UL, 0xd20d85fdUL, 0xa50ab56bUL,
+    0x35b5a8faUL, 0x42b2986cUL, 0xdbbbc9d6UL, 0xacbcf940UL, 0x32d86ce3UL,
+    0x45df5c75UL, 0xdcd60dcfUL, 0xabd13d59UL, 0x26d930acUL, 0x51de003aUL,
+    0xc8d75180UL, 0xbfd06116UL, 0x21b4f4b5UL, 0x56b3c423UL, 0xcfba9599UL,
+    0xb8bda50fUL, 0x2802b89eUL, 0x5f058808UL, 0xc60cd9b2UL, 0xb10be924UL,
+    0x2f6f7c87UL, 0x58684c11UL, 0xc1611dabUL, 0xb6662d3dUL, 0x76dc4190UL,
+    0x01db7106UL, 0x98d220bcUL, 0xefd5102aUL, 0x71b18589UL, 0x06b6b51fUL,
+    0x9fbfe4a5UL, 0xe8b8d433UL, 0x7807c9a2UL, 0x0f00f934UL, 0x9609a88eUL,
+    0xe10e9818UL, 0x7f6a0dbbUL, 0x086d3d2dUL, 0x91646c97UL, 0xe6635c01UL,
+    0x6b6b51f4UL, 0x1c6c6162UL, 0x856530d8UL, 0xf262004eUL, 0x6c0695edUL,
+    0x1b01a57bUL, 0x8208f4c1UL, 0xf50fc457UL, 0x65b0d9c6UL, 0x12b7e950UL,
+    0x8bbeb8eaUL, 0xfcb9887cUL, 0x62dd1ddfUL, 0x15da2d49UL, 0x8cd37cf3UL,
+    0xfbd44c65UL, 0x4db26158UL, 0x3ab551ceUL, 0xa3bc0074UL, 0xd4bb30e2UL,
+    0x4adfa541UL, 0x3dd895d7UL, 0xa4d1c46dUL, 0xd3d6f4fbUL, 0x4369e96aUL,
+    0x346ed9fcUL, 0xad678846UL, 0xda60b8d0UL, 0x44042d73UL, 0x33031de5UL,
+    0xaa0a4c5fUL, 0xdd0d7cc9UL, 0x5005713cUL, 0x270241aaUL, 0xbe0b1010UL,
+    0xc90c2086UL, 0x5768b525UL, 0x206f85b3UL, 0xb966d409UL, 0xce61e49fUL,
+    0x5edef90eUL, 0x29d9c998UL, 0xb0d09822UL, 0xc7d7a8b4UL, 0x59b33d17UL,
+    0x2eb40d81UL, 0xb7bd5c3bUL, 0xc0ba6cadUL, 0xedb88320UL, 0x9abfb3b6UL,
+    0x03b6e20cUL, 0x74b1d29aUL, 0xead54739UL, 0x9dd277afUL, 0x04db2615UL,
+    0x73dc1683UL, 0xe3630b12UL, 0x94643b84UL, 0x0d6d6a3eUL, 0x7a6a5aa8UL,
+    0xe40ecf0bUL, 0x9309ff9dUL, 0x0a00ae27UL, 0x7d079eb1UL, 0xf00f9344UL,
+    0x8708a3d2UL, 0x1e01f268UL, 0x6906c2feUL, 0xf762575dUL, 0x806567cbUL,
+    0x196c3671UL, 0x6e6b06e7UL, 0xfed41b76UL, 0x89d32be0UL, 0x10da7a5aUL,
+    0x67dd4accUL, 0xf9b9df6fUL, 0x8ebeeff9UL, 0x17b7be43UL, 0x60b08ed5UL,
+    0xd6d6a3e8UL, 0xa1d1937eUL, 0x38d8c2c4UL, 0x4fdff252UL, 0xd1bb67f1UL,
+    0xa6bc5767UL, 0x3fb506ddUL, 0x48b2364bUL, 0xd80d2bdaUL, 0xaf0a1b4cUL,
+    0x36034af6UL, 0x41047a60UL, 0xdf60efc3UL, 0xa867df55UL, 0x316e8eefUL,
+    0x4669be79UL, 0xcb61b38cUL, 0xbc66831aUL, 0x256fd2a0UL, 0x5268e236UL,
+    0xcc0c7795UL, 0xbb0b4703UL, 0x220216b9UL, 0x5505262fUL, 0xc5ba3bbeUL,
+    0xb2bd0b28UL, 0x2bb45a92UL, 0x5cb36a04UL, 0xc2d7ffa7UL, 0xb5d0cf31UL,
+    0x2cd99e8bUL, 0x5bdeae1dUL, 0x9b64c2b0UL, 0xec63f226UL, 0x756aa39cUL,
+    0x026d930aUL, 0x9c0906a9UL, 0xeb0e363fUL, 0x72076785UL, 0x05005713UL,
+    0x95bf4a82UL, 0xe2b87a14UL, 0x7bb12baeUL, 0x0cb61b38UL, 0x92d28e9bUL,
+    0xe5d5be0dUL, 0x7cdcefb7UL, 0x0bdbdf21UL, 0x86d3d2d4UL, 0xf1d4e242UL,
+    0x68ddb3f8UL, 0x1fda836eUL, 0x81be16cdUL, 0xf6b9265bUL, 0x6fb077e1UL,
+    0x18b74777UL, 0x88085ae6UL, 0xff0f6a70UL, 0x66063bcaUL, 0x11010b5cUL,
+    0x8f659effUL, 0xf862ae69UL, 0x616bffd3UL, 0x166ccf45UL, 0xa00ae278UL,
+    0xd70dd2eeUL, 0x4e048354UL, 0x3903b3c2UL, 0xa7672661UL, 0xd06016f7UL,
+    0x4969474dUL, 0x3e6e77dbUL, 0xaed16a4aUL, 0xd9d65adcUL, 0x40df0b66UL,
+    0x37d83bf0UL, 0xa9bcae53UL, 0xdebb9ec5UL, 0x47b2cf7fUL, 0x30b5ffe9UL,
+    0xbdbdf21cUL, 0xcabac28aUL, 0x53b39330UL, 0x24b4a3a6UL, 0xbad03605UL,
+    0xcdd70693UL, 0x54de5729UL, 0x23d967bfUL, 0xb3667a2eUL, 0xc4614ab8UL,
+    0x5d681b02UL, 0x2a6f2b94UL, 0xb40bbe37UL, 0xc30c8ea1UL, 0x5a05df1bUL,
+    0x2d02ef8dUL
+  },
+  {
+    0x00000000UL, 0x191b3141UL, 0x32366282UL, 0x2b2d53c3UL, 0x646cc504UL,
+    0x7d77f445UL, 0x565aa786UL, 0x4f4196c7UL, 0xc8d98a08UL, 0xd1c2bb49UL,
+    0xfaefe88aUL, 0xe3f4d9cbUL, 0xacb54f0cUL, 0xb5ae7e4dUL, 0x9e832d8eUL,
+    0x87981ccfUL, 0x4ac21251UL, 0x53d92310UL, 0x78f470d3UL, 0x61ef4192UL,
+    0x2eaed755UL, 0x37b5e614UL, 0x1c98b5d7UL, 0x05838496UL, 0x821b9859UL,
+    0x9b00a918UL, 0xb02dfadbUL, 0xa936cb9aUL, 0xe6775d5dUL, 0xff6c6c1cUL,
+    0xd4413fdfUL, 0xcd5a0e9eUL, 0x958424a2UL, 0x8c9f15e3UL, 0xa7b24620UL,
+    0xbea97761UL, 0xf1e8e1a6UL, 0xe8f3d0e7UL, 0xc3de8324UL, 0xdac5b265UL,
+    0x5d5daeaaUL, 0x44469febUL, 0x6f6bcc28UL, 0x7670fd69UL, 0x39316baeUL,
+    0x202a5aefUL, 0x0b07092cUL, 0x121c386dUL, 0xdf4636f3UL, 0xc65d07b2UL,
+    0xed705471UL, 0xf46b6530UL, 0xbb2af3f7UL, 0xa231c2b6UL, 0x891c9175UL,
+    0x9007a034UL, 0x179fbcfbUL, 0x0e848dbaUL, 0x25a9de79UL, 0x3cb2ef38UL,
+    0x73f379ffUL, 0x6ae848beUL, 0x41c51b7dUL, 0x58de2a3cUL, 0xf0794f05UL,
+    0xe9627e44UL, 0xc24f2d87UL, 0xdb541cc6UL, 0x94158a01UL, 0x8d0ebb40UL,
+    0xa623e883UL, 0xbf38d9c2UL, 0x38a0c50dUL, 0x21bbf44cUL, 0x0a96a78fUL,
+    0x138d96ceUL, 0x5ccc0009UL, 0x45d73148UL, 0x6efa628bUL, 0x77e153caUL,
+    0xbabb5d54UL, 0xa3a06c15UL, 0x888d3fd6UL, 0x91960e97UL, 0xded79850UL,
+    0xc7cca911UL, 0xece1fad2UL, 0xf5facb93UL, 0x7262d75cUL, 0x6b79e61dUL,
+    0x4054b5deUL, 0x594f849fUL, 0x160e1258UL, 0x0f152319UL, 0x243870daUL,
+    0x3d23419bUL, 0x65fd6ba7UL, 0x7ce65ae6UL, 0x57cb0925UL, 0x4ed03864UL,
+    0x0191aea3UL, 0x188a9fe2UL, 0x33a7cc21UL, 0x2abcfd60UL, 0xad24e1afUL,
+    0xb43fd0eeUL, 0x9f12832dUL, 0x8609b26cUL, 0xc94824abUL, 0xd05315eaUL,
+    0xfb7e4629UL, 0xe2657768UL, 0x2f3f79f6UL, 0x362448b7UL, 0x1d091b74UL,
+    0x04122a35UL, 0x4b53bcf2UL, 0x52488db3UL, 0x7965de70UL, 0x607eef31UL,
+    0xe7e6f3feUL, 0xfefdc2bfUL, 0xd5d0917cUL, 0xcccba03dUL, 0x838a36faUL,
+    0x9a9107bbUL, 0xb1bc5478UL, 0xa8a76539UL, 0x3b83984bUL, 0x2298a90aUL,
+    0x09b5fac9UL, 0x10aecb88UL, 0x5fef5d4fUL, 0x46f46c0eUL, 0x6dd93fcdUL,
+    0x74c20e8cUL, 0xf35a1243UL, 0xea412302UL, 0xc16c70c1UL, 0xd8774180UL,
+    0x9736d747UL, 0x8e2de606UL, 0xa500b5c5UL, 0xbc1b8484UL, 0x71418a1aUL,
+    0x685abb5bUL, 0x4377e898UL, 0x5a6cd9d9UL, 0x152d4f1eUL, 0x0c367e5fUL,
+    0x271b2d9cUL, 0x3e001cddUL, 0xb9980012UL, 0xa0833153UL, 0x8bae6290UL,
+    0x92b553d1UL, 0xddf4c516UL, 0xc4eff457UL, 0xefc2a794UL, 0xf6d996d5UL,
+    0xae07bce9UL, 0xb71c8da8UL, 0x9c31de6bUL, 0x852aef2aUL, 0xca6b79edUL,
+    0xd37048acUL, 0xf85d1b6fUL, 0xe1462a2eUL, 0x66de36e1UL, 0x7fc507a0UL,
+    0x54e85463UL, 0x4df36522UL, 0x02b2f3e5UL, 0x1ba9c2a4UL, 0x30849167UL,
+    0x299fa026UL, 0xe4c5aeb8UL, 0xfdde9ff9UL, 0xd6f3cc3aUL, 0xcfe8fd7bUL,
+    0x80a96bbcUL, 0x99b25afdUL, 0xb29f093eUL, 0xab84387fUL, 0x2c1c24b0UL,
+    0x350715f1UL, 0x1e2a4632UL, 0x07317773UL, 0x4870e1b4UL, 0x516bd0f5UL,
+    0x7a468336UL, 0x635db277UL, 0xcbfad74eUL, 0xd2e1e60fUL, 0xf9ccb5ccUL,
+    0xe0d7848dUL, 0xaf96124aUL, 0xb68d230bUL, 0x9da070c8UL, 0x84bb4189UL,
+    0x03235d46UL, 0x1a386c07UL, 0x31153fc4UL, 0x280e0e85UL, 0x674f9842UL,
+    0x7e54a903UL, 0x5579fac0UL, 0x4c62cb81UL, 0x8138c51fUL, 0x9823f45eUL,
+    0xb30ea79dUL, 0xaa1596dcUL, 0xe554001bUL, 0xfc4f315aUL, 0xd7626299UL,
+    0xce7953d8UL, 0x49e14f17UL, 0x50fa7e56UL, 0x7bd72d95UL, 0x62cc1cd4UL,
+    0x2d8d8a13UL, 0x3496bb52UL, 0x1fbbe891UL, 0x06a0d9d0UL, 0x5e7ef3ecUL,
+    0x4765c2adUL, 0x6c48916eUL, 0x7553a02fUL, 0x3a1236e8UL, 0x230907a9UL,
+    0x0824546aUL, 0x113f652bUL, 0x96a779e4UL, 0x8fbc48a5UL, 0xa4911b66UL,
+    0xbd8a2a27UL, 0xf2cbbce0UL, 0xebd08da1UL, 0xc0fdde62UL, 0xd9e6ef23UL,
+    0x14bce1bdUL, 0x0da7d0fcUL, 0x268a833fUL, 0x3f91b27eUL, 0x70d024b9UL,
+    0x69cb15f8UL, 0x42e6463bUL, 0x5bfd777aUL, 0xdc656bb5UL, 0xc57e5af4UL,
+    0xee530937UL, 0xf7483876UL, 0xb809aeb1UL, 0xa1129ff0UL, 0x8a3fcc33UL,
+    0x9324fd72UL
+  },
+  {
+    0x00000000UL, 0x01c26a37UL, 0x0384d46eUL, 0x0246be59UL, 0x0709a8dcUL,
+    0x06cbc2ebUL, 0x048d7cb2UL, 0x054f1685UL, 0x0e1351b8UL, 0x0fd13b8fUL,
+    0x0d9785d6UL, 0x0c55efe1UL, 0x091af964UL, 0x08d89353UL, 0x0a9e2d0aUL,
+    0x0b5c473dUL, 0x1c26a370UL, 0x1de4c947UL, 0x1fa2771eUL, 0x1e601d29UL,
+    0x1b2f0bacUL, 0x1aed619bUL, 0x18abdfc2UL, 0x1969b5f5UL, 0x1235f2c8UL,
+    0x13f798ffUL, 0x11b126a6UL, 0x10734c91UL, 0x153c5a14UL, 0x14fe3023UL,
+    0x16b88e7aUL, 0x177ae44dUL, 0x384d46e0UL, 0x398f2cd7UL, 0x3bc9928eUL,
+    0x3a0bf8b9UL, 0x3f44ee3cUL, 0x3e86840bUL, 0x3cc03a52UL, 0x3d025065UL,
+    0x365e1758UL, 0x379c7d6fUL, 0x35dac336UL, 0x3418a901UL, 0x3157bf84UL,
+    0x3095d5b3UL, 0x32d36beaUL, 0x331101ddUL, 0x246be590UL, 0x25a98fa7UL,
+    0x27ef31feUL, 0x262d5bc9UL, 0x23624d4cUL, 0x22a0277bUL, 0x20e69922UL,
+    0x2124f315UL, 0x2a78b428UL, 0x2bbade1fUL, 0x29fc6046UL, 0x283e0a71UL,
+    0x2d711cf4UL, 0x2cb376c3UL, 0x2ef5c89aUL, 0x2f37a2adUL, 0x709a8dc0UL,
+    0x7158e7f7UL, 0x731e59aeUL, 0x72dc3399UL, 0x7793251cUL, 0x76514f2bUL,
+    0x7417f172UL, 0x75d59b45UL, 0x7e89dc78UL, 0x7f4bb64fUL, 0x7d0d0816UL,
+    0x7ccf6221UL, 0x798074a4UL, 0x78421e93UL, 0x7a04a0caUL, 0x7bc6cafdUL,
+    0x6cbc2eb0UL, 0x6d7e4487UL, 0x6f38fadeUL, 0x6efa90e9UL, 0x6bb5866cUL,
+    0x6a77ec5bUL, 0x68315202UL, 0x69f33835UL, 0x62af7f08UL, 0x636d153fUL,
+    0x612bab66UL, 0x60e9c151UL, 0x65a6d7d4UL, 0x6464bde3UL, 0x662203baUL,
+    0x67e0698dUL, 0x48d7cb20UL, 0x4915a117UL, 0x4b531f4eUL, 0x4a917579UL,
+    0x4fde63fcUL, 0x4e1c09cbUL, 0x4c5ab792UL, 0x4d98dda5UL, 0x46c49a98UL,
+    0x4706f0afUL, 0x45404ef6UL, 0x448224c1UL, 0x41cd3244UL, 0x400f5873UL,
+    0x4249e62aUL, 0x438b8c1dUL, 0x54f16850UL, 0x55330267UL, 0x5775bc3eUL,
+    0x56b7d609UL, 0x53f8c08cUL, 0x523aaabbUL, 0x507c14e2UL, 0x51be7ed5UL,
+    0x5ae239e8UL, 0x5b2053dfUL, 0x5966ed86UL, 0x58a487b1UL, 0x5deb9134UL,
+    0x5c29fb03UL, 0x5e6f455aUL, 0x5fad2f6dUL, 0xe1351b80UL, 0xe0f771b7UL,
+    0xe2b1cfeeUL, 0xe373a5d9UL, 0xe63cb35cUL, 0xe7fed96bUL, 0xe5b86732UL,
+    0xe47a0d05UL, 0xef264a38UL, 0xeee4200fUL, 0xeca29e56UL, 0xed60f461UL,
+    0xe82fe2e4UL, 0xe9ed88d3UL, 0xebab368aUL, 0xea695cbdUL, 0xfd13b8f0UL,
+    0xfcd1d2c7UL, 0xfe976c9eUL, 0xff5506a9UL, 0xfa1a102cUL, 0xfbd87a1bUL,
+    0xf99ec442UL, 0xf85cae75UL, 0xf300e948UL, 0xf2c2837fUL, 0xf0843d26UL,
+    0xf1465711UL, 0xf4094194UL, 0xf5cb2ba3UL, 0xf78d95faUL, 0xf64fffcdUL,
+    0xd9785d60UL, 0xd8ba3757UL, 0xdafc890eUL, 0xdb3ee339UL, 0xde71f5bcUL,
+    0xdfb39f8bUL, 0xddf521d2UL, 0xdc374be5UL, 0xd76b0cd8UL, 0xd6a966efUL,
+    0xd4efd8b6UL, 0xd52db281UL, 0xd062a404UL, 0xd1a0ce33UL, 0xd3e6706aUL,
+    0xd2241a5dUL, 0xc55efe10UL, 0xc49c9427UL, 0xc6da2a7eUL, 0xc7184049UL,
+    0xc25756ccUL, 0xc3953cfbUL, 0xc1d382a2UL, 0xc011e895UL, 0xcb4dafa8UL,
+    0xca8fc59fUL, 0xc8c97bc6UL, 0xc90b11f1UL, 0xcc440774UL, 0xcd866d43UL,
+    0xcfc0d31aUL, 0xce02b92dUL, 0x91af9640UL, 0x906dfc77UL, 0x922b422eUL,
+    0x93e92819UL, 0x96a63e9cUL, 0x976454abUL, 0x9522eaf2UL, 0x94e080c5UL,
+    0x9fbcc7f8UL, 0x9e7eadcfUL, 0x9c381396UL, 0x9dfa79a1UL, 0x98b56f24UL,
+    0x99770513UL, 0x9b31bb4aUL, 0x9af3d17dUL, 0x8d893530UL, 0x8c4b5f07UL,
+    0x8e0de15eUL, 0x8fcf8b69UL, 0x8a809decUL, 0x8b42f7dbUL, 0x89044982UL,
+    0x88c623b5UL, 0x839a6488UL, 0x82580ebfUL, 0x801eb0e6UL, 0x81dcdad1UL,
+    0x8493cc54UL, 0x8551a663UL, 0x8717183aUL, 0x86d5720dUL, 0xa9e2d0a0UL,
+    0xa820ba97UL, 0xaa6604ceUL, 0xaba46ef9UL, 0xaeeb787cUL, 0xaf29124bUL,
+    0xad6fac12UL, 0xacadc625UL, 0xa7f18118UL, 0xa633eb2fUL, 0xa4755576UL,
+    0xa5b73f41UL, 0xa0f829c4UL, 0xa13a43f3UL, 0xa37cfdaaUL, 0xa2be979dUL,
+    0xb5c473d0UL, 0xb40619e7UL, 0xb640a7beUL, 0xb782cd89UL, 0xb2cddb0cUL,
+    0xb30fb13bUL, 0xb1490f62UL, 0xb08b6555UL, 0xbbd72268UL, 0xba15485fUL,
+    0xb853f606UL, 0xb9919c31UL, 0xbcde8ab4UL, 0xbd1ce083UL, 0xbf5a5edaUL,
+    0xbe9834edUL
+  },
+  {
+    0x00000000UL, 0xb8bc6765UL, 0xaa09c88bUL, 0x12b5afeeUL, 0x8f629757UL,
+    0x37def032UL, 0x256b5fdcUL, 0x9dd738b9UL, 0xc5b428efUL, 0x7d084f8aUL,
+    0x6fbde064UL, 0xd7018701UL, 0x4ad6bfb8UL, 0xf26ad8ddUL, 0xe0df7733UL,
+    0x58631056UL, 0x5019579fUL, 0xe8a530faUL, 0xfa109f14UL, 0x42acf871UL,
+    0xdf7bc0c8UL, 0x67c7a7adUL, 0x75720843UL, 0xcdce6f26UL, 0x95ad7f70UL,
+    0x2d111815UL, 0x3fa4b7fbUL, 0x8718d09eUL, 0x1acfe827UL, 0xa2738f42UL,
+    0xb0c620acUL, 0x087a47c9UL, 0xa032af3eUL, 0x188ec85bUL, 0x0a3b67b5UL,
+    0xb28700d0UL, 0x2f503869UL, 0x97ec5f0cUL, 0x8559f0e2UL, 0x3de59787UL,
+    0x658687d1UL, 0xdd3ae0b4UL, 0xcf8f4f5aUL, 0x7733283fUL, 0xeae41086UL,
+    0x525877e3UL, 0x40edd80dUL, 0xf851bf68UL, 0xf02bf8a1UL, 0x48979fc4UL,
+    0x5a22302aUL, 0xe29e574fUL, 0x7f496ff6UL, 0xc7f50893UL, 0xd540a77dUL,
+    0x6dfcc018UL, 0x359fd04eUL, 0x8d23b72bUL, 0x9f9618c5UL, 0x272a7fa0UL,
+    0xbafd4719UL, 0x0241207cUL, 0x10f48f92UL, 0xa848e8f7UL, 0x9b14583dUL,
+    0x23a83f58UL, 0x311d90b6UL, 0x89a1f7d3UL, 0x1476cf6aUL, 0xaccaa80fUL,
+    0xbe7f07e1UL, 0x06c36084UL, 0x5ea070d2UL, 0xe61c17b7UL, 0xf4a9b859UL,
+    0x4c15df3cUL, 0xd1c2e785UL, 0x697e80e0UL, 0x7bcb2f0eUL, 0xc377486bUL,
+    0xcb0d0fa2UL, 0x73b168c7UL, 0x6104c729UL, 0xd9b8a04cUL, 0x446f98f5UL,
+    0xfcd3ff90UL, 0xee66507eUL, 0x56da371bUL, 0x0eb9274dUL, 0xb6054028UL,
+    0xa4b0efc6UL, 0x1c0c88a3UL, 0x81dbb01aUL, 0x3967d77fUL, 0x2bd27891UL,
+    0x936e1ff4UL, 0x3b26f703UL, 0x839a9066UL, 0x912f3f88UL, 0x299358edUL,
+    0xb4446054UL, 0x0cf80731UL, 0x1e4da8dfUL, 0xa6f1cfbaUL, 0xfe92dfecUL,
+    0x462eb889UL, 0x549b1767UL, 0xec277002UL, 0x71f048bbUL, 0xc94c2fdeUL,
+    0xdbf98030UL, 0x6345e755UL, 0x6b3fa09cUL, 0xd383c7f9UL, 0xc1366817UL,
+    0x798a0f72UL, 0xe45d37cbUL, 0x5ce150aeUL, 0x4e54ff40UL, 0xf6e89825UL,
+    0xae8b8873UL, 0x1637ef16UL, 0x048240f8UL, 0xbc3e279dUL, 0x21e91f24UL,
+    0x99557841UL, 0x8be0d7afUL, 0x335cb0caUL, 0xed59b63bUL, 0x55e5d15eUL,
+    0x47507eb0UL, 0xffec19d5UL, 0x623b216cUL, 0xda874609UL, 0xc832e9e7UL,
+    0x708e8e82UL, 0x28ed9ed4UL, 0x9051f9b1UL, 0x82e4565fUL, 0x3a58313aUL,
+    0xa78f0983UL, 0x1f336ee6UL, 0x0d86c108UL, 0xb53aa66dUL, 0xbd40e1a4UL,
+    0x05fc86c1UL, 0x1749292fUL, 0xaff54e4aUL, 0x322276f3UL, 0x8a9e1196UL,
+    0x982bbe78UL, 0x2097d91dUL, 0x78f4c94bUL, 0xc048ae2eUL, 0xd2fd01c0UL,
+    0x6a4166a5UL, 0xf7965e1cUL, 0x4f2a3979UL, 0x5d9f9697UL, 0xe523f1f2UL,
+    0x4d6b1905UL, 0xf5d77e60UL, 0xe762d18eUL, 0x5fdeb6ebUL, 0xc2098e52UL,
+    0x7ab5e937UL, 0x680046d9UL, 0xd0bc21bcUL, 0x88df31eaUL, 0x3063568fUL,
+    0x22d6f961UL, 0x9a6a9e04UL, 0x07bda6bdUL, 0xbf01c1d8UL, 0xadb46e36UL,
+    0x15080953UL, 0x1d724e9aUL, 0xa5ce29ffUL, 0xb77b8611UL, 0x0fc7e174UL,
+    0x9210d9cdUL, 0x2aacbea8UL, 0x38191146UL, 0x80a57623UL, 0xd8c66675UL,
+    0x607a0110UL, 0x72cfaefeUL, 0xca73c99bUL, 0x57a4f122UL, 0xef189647UL,
+    0xfdad39a9UL, 0x45115eccUL, 0x764dee06UL, 0xcef18963UL, 0xdc44268dUL,
+    0x64f841e8UL, 0xf92f7951UL, 0x41931e34UL, 0x5326b1daUL, 0xeb9ad6bfUL,
+    0xb3f9c6e9UL, 0x0b45a18cUL, 0x19f00e62UL, 0xa14c6907UL, 0x3c9b51beUL,
+    0x842736dbUL, 0x96929935UL, 0x2e2efe50UL, 0x2654b999UL, 0x9ee8defcUL,
+    0x8c5d7112UL, 0x34e11677UL, 0xa9362eceUL, 0x118a49abUL, 0x033fe645UL,
+    0xbb838120UL, 0xe3e09176UL, 0x5b5cf613UL, 0x49e959fdUL, 0xf1553e98UL,
+    0x6c820621UL, 0xd43e6144UL, 0xc68bceaaUL, 0x7e37a9cfUL, 0xd67f4138UL,
+    0x6ec3265dUL, 0x7c7689b3UL, 0xc4caeed6UL, 0x591dd66fUL, 0xe1a1b10aUL,
+    0xf3141ee4UL, 0x4ba87981UL, 0x13cb69d7UL, 0xab770eb2UL, 0xb9c2a15cUL,
+    0x017ec639UL, 0x9ca9fe80UL, 0x241599e5UL, 0x36a0360bUL, 0x8e1c516eUL,
+    0x866616a7UL, 0x3eda71c2UL, 0x2c6fde2cUL, 0x94d3b949UL, 0x090481f0UL,
+    0xb1b8e695UL, 0xa30d497bUL, 0x1bb12e1eUL, 0x43d23e48UL, 0xfb6e592dUL,
+    0xe9dbf6c3UL, 0x516791a6UL, 0xccb0a91fUL, 0x740cce7aUL, 0x66b96194UL,
+    0xde0506f1UL
+  },
+  {
+    0x00000000UL, 0x3d6029b0UL, 0x7ac05360UL, 0x47a07ad0UL, 0xf580a6c0UL,
+    0xc8e08f70UL, 0x8f40f5a0UL, 0xb220dc10UL, 0x30704bc1UL, 0x0d106271UL,
+    0x4ab018a1UL, 0x77d03111UL, 0xc5f0ed01UL, 0xf890c4b1UL, 0xbf30be61UL,
+    0x825097d1UL, 0x60e09782UL, 0x5d80be32UL, 0x1a20c4e2UL, 0x2740ed52UL,
+    0x95603142UL, 0xa80018f2UL, 0xefa06222UL, 0xd2c04b92UL, 0x5090dc43UL,
+    0x6df0f5f3UL, 0x2a508f23UL, 0x1730a693UL, 0xa5107a83UL, 0x98705333UL,
+    0xdfd029e3UL, 0xe2b00053UL, 0xc1c12f04UL, 0xfca106b4UL, 0xbb017c64UL,
+    0x866155d4UL, 0x344189c4UL, 0x0921a074UL, 0x4e81daa4UL, 0x73e1f314UL,
+    0xf1b164c5UL, 0xccd14d75UL, 0x8b7137a5UL, 0xb6111e15UL, 0x0431c205UL,
+    0x3951ebb5UL, 0x7ef19165UL, 0x4391b8d5UL, 0xa121b886UL, 0x9c419136UL,
+    0xdbe1ebe6UL, 0xe681c256UL, 0x54a11e46UL, 0x69c137f6UL, 0x2e614d26UL,
+    0x13016496UL, 0x9151f347UL, 0xac31daf7UL, 0xeb91a027UL, 0xd6f18997UL,
+    0x64d15587UL, 0x59b17c37UL, 0x1e1106e7UL, 0x23712f57UL, 0x58f35849UL,
+    0x659371f9UL, 0x22330b29UL, 0x1f532299UL, 0xad73fe89UL, 0x9013d739UL,
+    0xd7b3ade9UL, 0xead38459UL, 0x68831388UL, 0x55e33a38UL, 0x124340e8UL,
+    0x2f236958UL, 0x9d03b548UL, 0xa0639cf8UL, 0xe7c3e628UL, 0xdaa3cf98UL,
+    0x3813cfcbUL, 0x0573e67bUL, 0x42d39cabUL, 0x7fb3b51bUL, 0xcd93690bUL,
+    0xf0f340bbUL, 0xb7533a6bUL, 0x8a3313dbUL, 0x0863840aUL, 0x3503adbaUL,
+    0x72a3d76aUL, 0x4fc3fedaUL, 0xfde322caUL, 0xc0830b7aUL, 0x872371aaUL,
+    0xba43581aUL, 0x9932774dUL, 0xa4525efdUL, 0xe3f2242dUL, 0xde920d9dUL,
+    0x6cb2d18dUL, 0x51d2f83dUL, 0x167282edUL, 0x2b12ab5dUL, 0xa9423c8cUL,
+    0x9422153cUL, 0xd3826fecUL, 0xeee2465cUL, 0x5cc29a4cUL, 0x61a2b3fcUL,
+    0x2602c92cUL, 0x1b62e09cUL, 0xf9d2e0cfUL, 0xc4b2c97fUL, 0x8312b3afUL,
+    0xbe729a1fUL, 0x0c52460fUL, 0x31326fbfUL, 0x7692156fUL, 0x4bf23cdfUL,
+    0xc9a2ab0eUL, 0xf4c282beUL, 0xb362f86eUL, 0x8e02d1deUL, 0x3c220dceUL,
+    0x0142247eUL, 0x46e25eaeUL, 0x7b82771eUL, 0xb1e6b092UL, 0x8c869922UL,
+    0xcb26e3f2UL, 0xf646ca42UL, 0x44661652UL, 0x79063fe2UL, 0x3ea64532UL,
+    0x03c66c82UL, 0x8196fb53UL, 0xbcf6d2e3UL, 0xfb56a833UL, 0xc6368183UL,
+    0x74165d93UL, 0x49767423UL, 0x0ed60ef3UL, 0x33b62743UL, 0xd1062710UL,
+    0xec660ea0UL, 0xabc67470UL, 0x96a65dc0UL, 0x248681d0UL, 0x19e6a860UL,
+    0x5e46d2b0UL, 0x6326fb00UL, 0xe1766cd1UL, 0xdc164561UL, 0x9bb63fb1UL,
+    0xa6d61601UL, 0x14f6ca11UL, 0x2996e3a1UL, 0x6e369971UL, 0x5356b0c1UL,
+    0x70279f96UL, 0x4d47b626UL, 0x0ae7ccf6UL, 0x3787e546UL, 0x85a73956UL,
+    0xb8c710e6UL, 0xff676a36UL, 0xc2074386UL, 0x4057d457UL, 0x7d37fde7UL,
+    0x3a978737UL, 0x07f7ae87UL, 0xb5d77297UL, 0x88b75b27UL, 0xcf1721f7UL,
+    0xf2770847UL, 0x10c70814UL, 0x2da721a4UL, 0x6a075b74UL, 0x576772c4UL,
+    0xe547aed4UL, 0xd8278764UL, 0x9f87fdb4UL, 0xa2e7d404UL, 0x20b743d5UL,
+    0x1dd76a65UL, 0x5a7710b5UL, 0x67173905UL, 0xd537e515UL, 0xe857cca5UL,
+    0xaff7b675UL, 0x92979fc5UL, 0xe915e8dbUL, 0xd475c16bUL, 0x93d5bbbbUL,
+    0xaeb5920bUL, 0x1c954e1bUL, 0x21f567abUL, 0x66551d7bUL, 0x5b3534cbUL,
+    0xd965a31aUL, 0xe4058aaaUL, 0xa3a5f07aUL, 0x9ec5d9caUL, 0x2ce505daUL,
+    0x11852c6aUL, 0x562556baUL, 0x6b457f0aUL, 0x89f57f59UL, 0xb49556e9UL,
+    0xf3352c39UL, 0xce550589UL, 0x7c75d999UL, 0x4115f029UL, 0x06b58af9UL,
+    0x3bd5a349UL, 0xb9853498UL, 0x84e51d28UL, 0xc34567f8UL, 0xfe254e48UL,
+    0x4c059258UL, 0x7165bbe8UL, 0x36c5c138UL, 0x0ba5e888UL, 0x28d4c7dfUL,
+    0x15b4ee6fUL, 0x521494bfUL, 0x6f74bd0fUL, 0xdd54611fUL, 0xe03448afUL,
+    0xa794327fUL, 0x9af41bcfUL, 0x18a48c1eUL, 0x25c4a5aeUL, 0x6264df7eUL,
+    0x5f04f6ceUL, 0xed242adeUL, 0xd044036eUL, 0x97e479beUL, 0xaa84500eUL,
+    0x4834505dUL, 0x755479edUL, 0x32f4033dUL, 0x0f942a8dUL, 0xbdb4f69dUL,
+    0x80d4df2dUL, 0xc774a5fdUL, 0xfa148c4dUL, 0x78441b9cUL, 0x4524322cUL,
+    0x028448fcUL, 0x3fe4614cUL, 0x8dc4bd5cUL, 0xb0a494ecUL, 0xf704ee3cUL,
+    0xca64c78cUL
+  },
+  {
+    0x00000000UL, 0xcb5cd3a5UL, 0x4dc8a10bUL, 0x869472aeUL, 0x9b914216UL,
+    0x50cd91b3UL, 0xd659e31dUL, 0x1d0530b8UL, 0xec53826dUL, 0x270f51c8UL,
+    0xa19b2366UL, 0x6ac7f0c3UL, 0x77c2c07bUL, 0xbc9e13deUL, 0x3a0a6170UL,
+    0xf156b2d5UL, 0x03d6029bUL, 0xc88ad13eUL, 0x4e1ea390UL, 0x85427035UL,
+    0x9847408dUL, 0x531b9328UL, 0xd58fe186UL, 0x1ed33223UL, 0xef8580f6UL,
+    0x24d95353UL, 0xa24d21fdUL, 0x6911f258UL, 0x7414c2e0UL, 0xbf481145UL,
+    0x39dc63ebUL, 0xf280b04eUL, 0x07ac0536UL, 0xccf0d693UL, 0x4a64a43dUL,
+    0x81387798UL, 0x9c3d4720UL, 0x57619485UL, 0xd1f5e62bUL, 0x1aa9358eUL,
+    0xebff875bUL, 0x20a354feUL, 0xa6372650UL, 0x6d6bf5f5UL, 0x706ec54dUL,
+    0xbb3216e8UL, 0x3da66446UL, 0xf6fab7e3UL, 0x047a07adUL, 0xcf26d408UL,
+    0x49b2a6a6UL, 0x82ee7503UL, 0x9feb45bbUL, 0x54b7961eUL, 0xd223e4b0UL,
+    0x197f3715UL, 0xe82985c0UL, 0x23755665UL, 0xa5e124cbUL, 0x6ebdf76eUL,
+    0x73b8c7d6UL, 0xb8e41473UL, 0x3e7066ddUL, 0xf52cb578UL, 0x0f580a6cUL,
+    0xc404d9c9UL, 0x4290ab67UL, 0x89cc78c2UL, 0x94c9487aUL, 0x5f959bdfUL,
+    0xd901e971UL, 0x125d3ad4UL, 0xe30b8801UL, 0x28575ba4UL, 0xaec3290aUL,
+    0x659ffaafUL, 0x789aca17UL, 0xb3c619b2UL, 0x35526b1cUL, 0xfe0eb8b9UL,
+    0x0c8e08f7UL, 0xc7d2db52UL, 0x4146a9fcUL, 0x8a1a7a59UL, 0x971f4ae1UL,
+    0x5c439944UL, 0xdad7ebeaUL, 0x118b384fUL, 0xe0dd8a9aUL, 0x2b81593fUL,
+    0xad152b91UL, 0x6649f834UL, 0x7b4cc88cUL, 0xb0101b29UL, 0x36846987UL,
+    0xfdd8ba22UL, 0x08f40f5aUL, 0xc3a8dcffUL, 0x453cae51UL, 0x8e607df4UL,
+    0x93654d4cUL, 0x58399ee9UL, 0xdeadec47UL, 0x15f13fe2UL, 0xe4a78d37UL,
+    0x2ffb5e92UL, 0xa96f2c3cUL, 0x6233ff99UL, 0x7f36cf21UL, 0xb46a1c84UL,
+    0x32fe6e2aUL, 0xf9a2bd8fUL, 0x0b220dc1UL, 0xc07ede64UL, 0x46eaaccaUL,
+    0x8db67f6fUL, 0x90b34fd7UL, 0x5bef9c72UL, 0xdd7beedcUL, 0x16273d79UL,
+    0xe7718facUL, 0x2c2d5c09UL, 0xaab92ea7UL, 0x61e5fd02UL, 0x7ce0cdbaUL,
+    0xb7bc1e1fUL, 0x31286cb1UL, 0xfa74bf14UL, 0x1eb014d8UL, 0xd5ecc77dUL,
+    0x5378b5d3UL, 0x98246676UL, 0x852156ceUL, 0x4e7d856bUL, 0xc8e9f7c5UL,
+    0x03b52460UL, 0xf2e396b5UL, 0x39bf4510UL, 0xbf2b37beUL, 0x7477e41bUL,
+    0x6972d4a3UL, 0xa22e0706UL, 0x24ba75a8UL, 0xefe6a60dUL, 0x1d661643UL,
+    0xd63ac5e6UL, 0x50aeb748UL, 0x9bf264edUL, 0x86f75455UL, 0x4dab87f0UL,
+    0xcb3ff55eUL, 0x006326fbUL, 0xf135942eUL, 0x3a69478bUL, 0xbcfd3525UL,
+    0x77a1e680UL, 0x6aa4d638UL, 0xa1f8059dUL, 0x276c7733UL, 0xec30a496UL,
+    0x191c11eeUL, 0xd240c24bUL, 0x54d4b0e5UL, 0x9f886340UL, 0x828d53f8UL,
+    0x49d1805dUL, 0xcf45f2f3UL, 0x04192156UL, 0xf54f9383UL, 0x3e134026UL,
+    0xb8873288UL, 0x73dbe12dUL, 0x6eded195UL, 0xa5820230UL, 0x2316709eUL,
+    0xe84aa33bUL, 0x1aca1375UL, 0xd196c0d0UL, 0x5702b27eUL, 0x9c5e61dbUL,
+    0x815b5163UL, 0x4a0782c6UL, 0xcc93f068UL, 0x07cf23cdUL, 0xf6999118UL,
+    0x3dc542bdUL, 0xbb513013UL, 0x700de3b6UL, 0x6d08d30eUL, 0xa65400abUL,
+    0x20c07205UL, 0xeb9ca1a0UL, 0x11e81eb4UL, 0xdab4cd11UL, 0x5c20bfbfUL,
+    0x977c6c1aUL, 0x8a795ca2UL, 0x41258f07UL, 0xc7b1fda9UL, 0x0ced2e0cUL,
+    0xfdbb9cd9UL, 0x36e74f7cUL, 0xb0733dd2UL, 0x7b2fee77UL, 0x662adecfUL,
+    0xad760d6aUL, 0x2be27fc4UL, 0xe0beac61UL, 0x123e1c2fUL, 0xd962cf8aUL,
+    0x5ff6bd24UL, 0x94aa6e81UL, 0x89af5e39UL, 0x42f38d9cUL, 0xc467ff32UL,
+    0x0f3b2c97UL, 0xfe6d9e42UL, 0x35314de7UL, 0xb3a53f49UL, 0x78f9ececUL,
+    0x65fcdc54UL, 0xaea00ff1UL, 0x28347d5fUL, 0xe368aefaUL, 0x16441b82UL,
+    0xdd18c827UL, 0x5b8cba89UL, 0x90d0692cUL, 0x8dd55994UL, 0x46898a31UL,
+    0xc01df89fUL, 0x0b412b3aUL, 0xfa1799efUL, 0x314b4a4aUL, 0xb7df38e4UL,
+    0x7c83eb41UL, 0x6186dbf9UL, 0xaada085cUL, 0x2c4e7af2UL, 0xe712a957UL,
+    0x15921919UL, 0xdececabcUL, 0x585ab812UL, 0x93066bb7UL, 0x8e035b0fUL,
+    0x455f88aaUL, 0xc3cbfa04UL, 0x089729a1UL, 0xf9c19b74UL, 0x329d48d1UL,
+    0xb4093a7fUL, 0x7f55e9daUL, 0x6250d962UL, 0xa90c0ac7UL, 0x2f987869UL,
+    0xe4c4abccUL
+  },
+  {
+    0x00000000UL, 0xa6770bb4UL, 0x979f1129UL, 0x31e81a9dUL, 0xf44f2413UL,
+    0x52382fa7UL, 0x63d0353aUL, 0xc5a73e8eUL, 0x33ef4e67UL, 0x959845d3UL,
+    0xa4705f4eUL, 0x020754faUL, 0xc7a06a74UL, 0x61d761c0UL, 0x503f7b5dUL,
+    0xf64870e9UL, 0x67de9cceUL, 0xc1a9977aUL, 0xf0418de7UL, 0x56368653UL,
+    0x9391b8ddUL, 0x35e6b369UL, 0x040ea9f4UL, 0xa279a240UL, 0x5431d2a9UL,
+    0xf246d91dUL, 0xc3aec380UL, 0x65d9c834UL, 0xa07ef6baUL, 0x0609fd0eUL,
+    0x37e1e793UL, 0x9196ec27UL, 0xcfbd399cUL, 0x69ca3228UL, 0x582228b5UL,
+    0xfe552301UL, 0x3bf21d8fUL, 0x9d85163bUL, 0xac6d0ca6UL, 0x0a1a0712UL,
+    0xfc5277fbUL, 0x5a257c4fUL, 0x6bcd66d2UL, 0xcdba6d66UL, 0x081d53e8UL,
+    0xae6a585cUL, 0x9f8242c1UL, 0x39f54975UL, 0xa863a552UL, 0x0e14aee6UL,
+    0x3ffcb47bUL, 0x998bbfcfUL, 0x5c2c8141UL, 0xfa5b8af5UL, 0xcbb39068UL,
+    0x6dc49bdcUL, 0x9b8ceb35UL, 0x3dfbe081UL, 0x0c13fa1cUL, 0xaa64f1a8UL,
+    0x6fc3cf26UL, 0xc9b4c492UL, 0xf85cde0fUL, 0x5e2bd5bbUL, 0x440b7579UL,
+    0xe27c7ecdUL, 0xd3946450UL, 0x75e36fe4UL, 0xb044516aUL, 0x16335adeUL,
+    0x27db4043UL, 0x81ac4bf7UL, 0x77e43b1eUL, 0xd19330aaUL, 0xe07b2a37UL,
+    0x460c2183UL, 0x83ab1f0dUL, 0x25dc14b9UL, 0x14340e24UL, 0xb2430590UL,
+    0x23d5e9b7UL, 0x85a2e203UL, 0xb44af89eUL, 0x123df32aUL, 0xd79acda4UL,
+    0x71edc610UL, 0x4005dc8dUL, 0xe672d739UL, 0x103aa7d0UL, 0xb64dac64UL,
+    0x87a5b6f9UL, 0x21d2bd4dUL, 0xe47583c3UL, 0x42028877UL, 0x73ea92eaUL,
+    0xd59d995eUL, 0x8bb64ce5UL, 0x2dc14751UL, 0x1c295dccUL, 0xba5e5678UL,
+    0x7ff968f6UL, 0xd98e6342UL, 0xe86679dfUL, 0x4e11726bUL, 0xb8590282UL,
+    0x1e2e0936UL, 0x2fc613abUL, 0x89b1181fUL, 0x4c162691UL, 0xea612d25UL,
+    0xdb8937b8UL, 0x7dfe3c0cUL, 0xec68d02bUL, 0x4a1fdb9fUL, 0x7bf7c102UL,
+    0xdd80cab6UL, 0x1827f438UL, 0xbe50ff8cUL, 0x8fb8e511UL, 0x29cfeea5UL,
+    0xdf879e4cUL, 0x79f095f8UL, 0x48188f65UL, 0xee6f84d1UL, 0x2bc8ba5fUL,
+    0x8dbfb1ebUL, 0xbc57ab76UL, 0x1a20a0c2UL, 0x8816eaf2UL, 0x2e61e146UL,
+    0x1f89fbdbUL, 0xb9fef06fUL, 0x7c59cee1UL, 0xda2ec555UL, 0xebc6dfc8UL,
+    0x4db1d47cUL, 0xbbf9a495UL, 0x1d8eaf21UL, 0x2c66b5bcUL, 0x8a11be08UL,
+    0x4fb68086UL, 0xe9c18b32UL, 0xd82991afUL, 0x7e5e9a1bUL, 0xefc8763cUL,
+    0x49bf7d88UL, 0x78576715UL, 0xde206ca1UL, 0x1b87522fUL, 0xbdf0599bUL,
+    0x8c184306UL, 0x2a6f48b2UL, 0xdc27385bUL, 0x7a5033efUL, 0x4bb82972UL,
+    0xedcf22c6UL, 0x28681c48UL, 0x8e1f17fcUL, 0xbff70d61UL, 0x198006d5UL,
+    0x47abd36eUL, 0xe1dcd8daUL, 0xd034c247UL, 0x7643c9f3UL, 0xb3e4f77dUL,
+    0x1593fcc9UL, 0x247be654UL, 0x820cede0UL, 0x74449d09UL, 0xd23396bdUL,
+    0xe3db8c20UL, 0x45ac8794UL, 0x800bb91aUL, 0x267cb2aeUL, 0x1794a833UL,
+    0xb1e3a387UL, 0x20754fa0UL, 0x86024414UL, 0xb7ea5e89UL, 0x119d553dUL,
+    0xd43a6bb3UL, 0x724d6007UL, 0x43a57a9aUL, 0xe5d2712eUL, 0x139a01c7UL,
+    0xb5ed0a73UL, 0x840510eeUL, 0x22721b5aUL, 0xe7d525d4UL, 0x41a22e60UL,
+    0x704a34fdUL, 0xd63d3f49UL, 0xcc1d9f8bUL, 0x6a6a943fUL, 0x5b828ea2UL,
+    0xfdf58516UL, 0x3852bb98UL, 0x9e25b02cUL, 0xafcdaab1UL, 0x09baa105UL,
+    0xfff2d1ecUL, 0x5985da58UL, 0x686dc0c5UL, 0xce1acb71UL, 0x0bbdf5ffUL,
+    0xadcafe4bUL, 0x9c22e4d6UL, 0x3a55ef62UL, 0xabc30345UL, 0x0db408f1UL,
+    0x3c5c126cUL, 0x9a2b19d8UL, 0x5f8c2756UL, 0xf9fb2ce2UL, 0xc813367fUL,
+    0x6e643dcbUL, 0x982c4d22UL, 0x3e5b4696UL, 0x0fb35c0bUL, 0xa9c457bfUL,
+    0x6c636931UL, 0xca146285UL, 0xfbfc7818UL, 0x5d8b73acUL, 0x03a0a617UL,
+    0xa5d7ada3UL, 0x943fb73eUL, 0x3248bc8aUL, 0xf7ef8204UL, 0x519889b0UL,
+    0x6070932dUL, 0xc6079899UL, 0x304fe870UL, 0x9638e3c4UL, 0xa7d0f959UL,
+    0x01a7f2edUL, 0xc400cc63UL, 0x6277c7d7UL, 0x539fdd4aUL, 0xf5e8d6feUL,
+    0x647e3ad9UL, 0xc209316dUL, 0xf3e12bf0UL, 0x55962044UL, 0x90311ecaUL,
+    0x3646157eUL, 0x07ae0fe3UL, 0xa1d90457UL, 0x579174beUL, 0xf1e67f0aUL,
+    0xc00e6597UL, 0x66796e23UL, 0xa3de50adUL, 0x05a95b19UL, 0x34414184UL,
+    0x92364a30UL
+  },
+  {
+    0x00000000UL, 0xccaa009eUL, 0x4225077dUL, 0x8e8f07e3UL, 0x844a0efaUL,
+    0x48e00e64UL, 0xc66f0987UL, 0x0ac50919UL, 0xd3e51bb5UL, 0x1f4f1b2bUL,
+    0x91c01cc8UL, 0x5d6a1c56UL, 0x57af154fUL, 0x9b0515d1UL, 0x158a1232UL,
+    0xd92012acUL, 0x7cbb312bUL, 0xb01131b5UL, 0x3e9e3656UL, 0xf23436c8UL,
+    0xf8f13fd1UL, 0x345b3f4fUL, 0xbad438acUL, 0x767e3832UL, 0xaf5e2a9eUL,
+    0x63f42a00UL, 0xed7b2de3UL, 0x21d12d7dUL, 0x2b142464UL, 0xe7be24faUL,
+    0x69312319UL, 0xa59b2387UL, 0xf9766256UL, 0x35dc62c8UL, 0xbb53652bUL,
+    0x77f965b5UL, 0x7d3c6cacUL, 0xb1966c32UL, 0x3f196bd1UL, 0xf3b36b4fUL,
+    0x2a9379e3UL, 0xe639797dUL, 0x68b67e9eUL, 0xa41c7e00UL, 0xaed97719UL,
+    0x62737787UL, 0xecfc7064UL, 0x205670faUL, 0x85cd537dUL, 0x496753e3UL,
+    0xc7e85400UL, 0x0b42549eUL, 0x01875d87UL, 0xcd2d5d19UL, 0x43a25afaUL,
+    0x8f085a64UL, 0x562848c8UL, 0x9a824856UL, 0x140d4fb5UL, 0xd8a74f2bUL,
+    0xd2624632UL, 0x1ec846acUL, 0x9047414fUL, 0x5ced41d1UL, 0x299dc2edUL,
+    0xe537c273UL, 0x6bb8c590UL, 0xa712c50eUL, 0xadd7cc17UL, 0x617dcc89UL,
+    0xeff2cb6aUL, 0x2358cbf4UL, 0xfa78d958UL, 0x36d2d9c6UL, 0xb85dde25UL,
+    0x74f7debbUL, 0x7e32d7a2UL, 0xb298d73cUL, 0x3c17d0dfUL, 0xf0bdd041UL,
+    0x5526f3c6UL, 0x998cf358UL, 0x1703f4bbUL, 0xdba9f425UL, 0xd16cfd3cUL,
+    0x1dc6fda2UL, 0x9349fa41UL, 0x5fe3fadfUL, 0x86c3e873UL, 0x4a69e8edUL,
+    0xc4e6ef0eUL, 0x084cef90UL, 0x0289e689UL, 0xce23e617UL, 0x40ace1f4UL,
+    0x8c06e16aUL, 0xd0eba0bbUL, 0x1c41a025UL, 0x92cea7c6UL, 0x5e64a758UL,
+    0x54a1ae41UL, 0x980baedfUL, 0x1684a93cUL, 0xda2ea9a2UL, 0x030ebb0eUL,
+    0xcfa4bb90UL, 0x412bbc73UL, 0x8d81bcedUL, 0x8744b5f4UL, 0x4beeb56aUL,
+    0xc561b289UL, 0x09cbb217UL, 0xac509190UL, 0x60fa910eUL, 0xee7596edUL,
+    0x22df9673UL, 0x281a9f6aUL, 0xe4b09ff4UL, 0x6a3f9817UL, 0xa6959889UL,
+    0x7fb58a25UL, 0xb31f8abbUL, 0x3d908d58UL, 0xf13a8dc6UL, 0xfbff84dfUL,
+    0x37558441UL, 0xb9da83a2UL, 0x7570833cUL, 0x533b85daUL, 0x9f918544UL,
+    0x111e82a7UL, 0xddb48239UL, 0xd7718b20UL, 0x1bdb8bbeUL, 0x95548c5dUL,
+    0x59fe8cc3UL, 0x80de9e6fUL, 0x4c749ef1UL, 0xc2fb9912UL, 0x0e51998cUL,
+    0x04949095UL, 0xc83e900bUL, 0x46b197e8UL, 0x8a1b9776UL, 0x2f80b4f1UL,
+    0xe32ab46fUL, 0x6da5b38cUL, 0xa10fb312UL, 0xabcaba0bUL, 0x6760ba95UL,
+    0xe9efbd76UL, 0x2545bde8UL, 0xfc65af44UL, 0x30cfafdaUL, 0xbe40a839UL,
+    0x72eaa8a7UL, 0x782fa1beUL, 0xb485a120UL, 0x3a0aa6c3UL, 0xf6a0a65dUL,
+    0xaa4de78cUL, 0x66e7e712UL, 0xe868e0f1UL, 0x24c2e06fUL, 0x2e07e976UL,
+    0xe2ade9e8UL, 0x6c22ee0bUL, 0xa088ee95UL, 0x79a8fc39UL, 0xb502fca7UL,
+    0x3b8dfb44UL, 0xf727fbdaUL, 0xfde2f2c3UL, 0x3148f25dUL, 0xbfc7f5beUL,
+    0x736df520UL, 0xd6f6d6a7UL, 0x1a5cd639UL, 0x94d3d1daUL, 0x5879d144UL,
+    0x52bcd85dUL, 0x9e16d8c3UL, 0x1099df20UL, 0xdc33dfbeUL, 0x0513cd12UL,
+    0xc9b9cd8cUL, 0x4736ca6fUL, 0x8b9ccaf1UL, 0x8159c3e8UL, 0x4df3c376UL,
+    0xc37cc495UL, 0x0fd6c40bUL, 0x7aa64737UL, 0xb60c47a9UL, 0x3883404aUL,
+    0xf42940d4UL, 0xfeec49cdUL, 0x32464953UL, 0xbcc94eb0UL, 0x70634e2eUL,
+    0xa9435c82UL, 0x65e95c1cUL, 0xeb665bffUL, 0x27cc5b61UL, 0x2d095278UL,
+    0xe1a352e6UL, 0x6f2c5505UL, 0xa386559bUL, 0x061d761cUL, 0xcab77682UL,
+    0x44387161UL, 0x889271ffUL, 0x825778e6UL, 0x4efd7878UL, 0xc0727f9bUL,
+    0x0cd87f05UL, 0xd5f86da9UL, 0x19526d37UL, 0x97dd6ad4UL, 0x5b776a4aUL,
+    0x51b26353UL, 0x9d1863cdUL, 0x1397642eUL, 0xdf3d64b0UL, 0x83d02561UL,
+    0x4f7a25ffUL, 0xc1f5221cUL, 0x0d5f2282UL, 0x079a2b9bUL, 0xcb302b05UL,
+    0x45bf2ce6UL, 0x89152c78UL, 0x50353ed4UL, 0x9c9f3e4aUL, 0x121039a9UL,
+    0xdeba3937UL, 0xd47f302eUL, 0x18d530b0UL, 0x965a3753UL, 0x5af037cdUL,
+    0xff6b144aUL, 0x33c114d4UL, 0xbd4e1337UL, 0x71e413a9UL, 0x7b211ab0UL,
+    0xb78b1a2eUL, 0x39041dcdUL, 0xf5ae1d53UL, 0x2c8e0fffUL, 0xe0240f61UL,
+    0x6eab0882UL, 0xa201081cUL, 0xa8c40105UL, 0x646e019bUL, 0xeae10678UL,
+    0x264b06e6UL
+  }
+};
+
+static const uint32_t crc_mpeg_table[8][256] = {
+  {
+    0x00000000UL, 0x04c11db7UL, 0x09823b6eUL, 0x0d4326d9UL, 0x130476dcUL,
+    0x17c56b6bUL, 0x1a864db2UL, 0x1e475005UL, 0x2608edb8UL, 0x22c9f00fUL,
+    0x2f8ad6d6UL, 0x2b4bcb61UL, 0x350c9b64UL, 0x31cd86d3UL, 0x3c8ea00aUL,
+    0x384fbdbdUL, 0x4c11db70UL, 0x48d0c6c7UL, 0x4593e01eUL, 0x4152fda9UL,
+    0x5f15adacUL, 0x5bd4b01bUL, 0x569796c2UL, 0x52568b75UL, 0x6a1936c8UL,
+    0x6ed82b7fUL, 0x639b0da6UL, 0x675a1011UL, 0x791d4014UL, 0x7ddc5da3UL,
+    0x709f7b7aUL, 0x745e66cdUL, 0x9823b6e0UL, 0x9ce2ab57UL, 0x91a18d8eUL,
+    0x95609039UL, 0x8b27c03cUL, 0x8fe6dd8bUL, 0x82a5fb52UL, 0x8664e6e5UL,
+    0xbe2b5b58UL, 0xbaea46efUL, 0xb7a96036UL, 0xb3687d81UL, 0xad2f2d84UL,
+    0xa9ee3033UL, 0xa4ad16eaUL, 0xa06c0b5dUL, 0xd4326d90UL, 0xd0f37027UL,
+    0xddb056feUL, 0xd9714b49UL, 0xc7361b4cUL, 0xc3f706fbUL, 0xceb42022UL,
+    0xca753d95UL, 0xf23a8028UL, 0xf6fb9d9fUL, 0xfbb8bb46UL, 0xff79a6f1UL,
+    0xe13ef6f4UL, 0xe5ffeb43UL, 0xe8bccd9aUL, 0xec7dd02dUL, 0x34867077UL,
+    0x30476dc0UL, 0x3d044b19UL, 0x39c556aeUL, 0x278206abUL, 0x23431b1cUL,
+    0x2e003dc5UL, 0x2ac12072UL, 0x128e9dcfUL, 0x164f8078UL, 0x1b0ca6a1UL,
+    0x1fcdbb16UL, 0x018aeb13UL, 0x054bf6a4UL, 0x0808d07dUL, 0x0cc9cdcaUL,
+    0x7897ab07UL, 0x7c56b6b0UL, 0x71159069UL, 0x75d48ddeUL, 0x6b93dddbUL,
+    0x6f52c06cUL, 0x6211e6b5UL, 0x66d0fb02UL, 0x5e9f46bfUL, 0x5a5e5b08UL,
+    0x571d7dd1UL, 0x53dc6066UL, 0x4d9b3063UL, 0x495a2dd4UL, 0x44190b0dUL,
+    0x40d816baUL, 0xaca5c697UL, 0xa864db20UL, 0xa527fdf9UL, 0xa1e6e04eUL,
+    0xbfa1b04bUL, 0xbb60adfcUL, 0xb6238b25UL, 0xb2e29692UL, 0x8aad2b2fUL,
+    0x8e6c3698UL, 0x832f1041UL, 0x87ee0df6UL, 0x99a95df3UL, 0x9d684044UL,
+    0x902b669dUL, 0x94ea7b2aUL, 0xe0b41de7UL, 0xe4750050UL, 0xe9362689UL,
+    0xedf73b3eUL, 0xf3b06b3bUL, 0xf771768cUL, 0xfa325055UL, 0xfef34de2UL,
+    0xc6bcf05fUL, 0xc27dede8UL, 0xcf3ecb31UL, 0xcbffd686UL, 0xd5b88683UL,
+    0xd1799b34UL, 0xdc3abdedUL, 0xd8fba05aUL, 0x690ce0eeUL, 0x6dcdfd59UL,
+    0x608edb80UL, 0x644fc637UL, 0x7a089632UL, 0x7ec98b85UL, 0x738aad5cUL,
+    0x774bb0ebUL, 0x4f040d56UL, 0x4bc510e1UL, 0x46863638UL, 0x42472b8fUL,
+    0x5c007b8aUL, 0x58c1663dUL, 0x558240e4UL, 0x51435d53UL, 0x251d3b9eUL,
+    0x21dc2629UL, 0x2c9f00f0UL, 0x285e1d47UL, 0x36194d42UL, 0x32d850f5UL,
+    0x3f9b762cUL, 0x3b5a6b9bUL, 0x0315d626UL, 0x07d4cb91UL, 0x0a97ed48UL,
+    0x0e56f0ffUL, 0x1011a0faUL, 0x14d0bd4dUL, 0x19939b94UL, 0x1d528623UL,
+    0xf12f560eUL, 0xf5ee4bb9UL, 0xf8ad6d60UL, 0xfc6c70d7UL, 0xe22b20d2UL,
+    0xe6ea3d65UL, 0xeba91bbcUL, 0xef68060bUL, 0xd727bbb6UL, 0xd3e6a601UL,
+    0xdea580d8UL, 0xda649d6fUL, 0xc423cd6aUL, 0xc0e2d0ddUL, 0xcda1f604UL,
+    0xc960ebb3UL, 0xbd3e8d7eUL, 0xb9ff90c9UL, 0xb4bcb610UL, 0xb07daba7UL,
+    0xae3afba2UL, 0xaafbe615UL, 0xa7b8c0ccUL, 0xa379dd7bUL, 0x9b3660c6UL,
+    0x9ff77d71UL, 0x92b45ba8UL, 0x9675461fUL, 0x8832161aUL, 0x8cf30badUL,
+    0x81b02d74UL, 0x857130c3UL, 0x5d8a9099UL, 0x594b8d2eUL, 0x5408abf7UL,
+    0x50c9b640UL, 0x4e8ee645UL, 0x4a4ffbf2UL, 0x470cdd2bUL, 0x43cdc09cUL,
+    0x7b827d21UL, 0x7f436096UL, 0x7200464fUL, 0x76c15bf8UL, 0x68860bfdUL,
+    0x6c47164aUL, 0x61043093UL, 0x65c52d24UL, 0x119b4be9UL, 0x155a565eUL,
+    0x18197087UL, 0x1cd86d30UL, 0x029f3d35UL, 0x065e2082UL, 0x0b1d065bUL,
+    0x0fdc1becUL, 0x3793a651UL, 0x3352bbe6UL, 0x3e119d3fUL, 0x3ad08088UL,
+    0x2497d08dUL, 0x2056cd3aUL, 0x2d15ebe3UL, 0x29d4f654UL, 0xc5a92679UL,
+    0xc1683bceUL, 0xcc2b1d17UL, 0xc8ea00a0UL, 0xd6ad50a5UL, 0xd26c4d12UL,
+    0xdf2f6bcbUL, 0xdbee767cUL, 0xe3a1cbc1UL, 0xe760d676UL, 0xea23f0afUL,
+    0xeee2ed18UL, 0xf0a5bd1dUL, 0xf464a0aaUL, 0xf9278673UL, 0xfde69bc4UL,
+    0x89b8fd09UL, 0x8d79e0beUL, 0x803ac667UL, 0x84fbdbd0UL, 0x9abc8bd5UL,
+    0x9e7d9662UL, 0x933eb0bbUL, 0x97ffad0cUL, 0xafb010b1UL, 0xab710d06UL,
+    0xa6322bdfUL, 0xa2f33668UL, 0xbcb4666dUL, 0xb8757bdaUL, 0xb5365d03UL,
+    0xb1f740b4UL
+  },
+  {
+    0x00000000UL, 0xd219c1dcUL, 0xa0f29e0fUL, 0x72eb5fd3UL, 0x452421a9UL,
+    0x973de075UL, 0xe5d6bfa6UL, 0x37cf7e7aUL, 0x8a484352UL, 0x5851828eUL,
+    0x2abadd5dUL, 0xf8a31c81UL, 0xcf6c62fbUL, 0x1d75a327UL, 0x6f9efcf4UL,
+    0xbd873d28UL, 0x10519b13UL, 0xc2485acfUL, 0xb0a3051cUL, 0x62bac4c0UL,
+    0x5575babaUL, 0x876c7b66UL, 0xf58724b5UL, 0x279ee569UL, 0x9a19d841UL,
+    0x4800199dUL, 0x3aeb464eUL, 0xe8f28792UL, 0xdf3df9e8UL, 0x0d243834UL,
+    0x7fcf67e7UL, 0xadd6a63bUL, 0x20a33626UL, 0xf2baf7faUL, 0x8051a829UL,
+    0x524869f5UL, 0x6587178fUL, 0xb79ed653UL, 0xc5758980UL, 0x176c485cUL,
+    0xaaeb7574UL, 0x78f2b4a8UL, 0x0a19eb7bUL, 0xd8002aa7UL, 0xefcf54ddUL,
+    0x3dd69501UL, 0x4f3dcad2UL, 0x9d240b0eUL, 0x30f2ad35UL, 0xe2eb6ce9UL,
+    0x9000333aUL, 0x4219f2e6UL, 0x75d68c9cUL, 0xa7cf4d40UL, 0xd5241293UL,
+    0x073dd34fUL, 0xbabaee67UL, 0x68a32fbbUL, 0x1a487068UL, 0xc851b1b4UL,
+    0xff9ecfceUL, 0x2d870e12UL, 0x5f6c51c1UL, 0x8d75901dUL, 0x41466c4cUL,
+    0x935fad90UL, 0xe1b4f243UL, 0x33ad339fUL, 0x04624de5UL, 0xd67b8c39UL,
+    0xa490d3eaUL, 0x76891236UL, 0xcb0e2f1eUL, 0x1917eec2UL, 0x6bfcb111UL,
+    0xb9e570cdUL, 0x8e2a0eb7UL, 0x5c33cf6bUL, 0x2ed890b8UL, 0xfcc15164UL,
+    0x5117f75fUL, 0x830e3683UL, 0xf1e56950UL, 0x23fca88cUL, 0x1433d6f6UL,
+    0xc62a172aUL, 0xb4c148f9UL, 0x66d88925UL, 0xdb5fb40dUL, 0x094675d1UL,
+    0x7bad2a02UL, 0xa9b4ebdeUL, 0x9e7b95a4UL, 0x4c625478UL, 0x3e890babUL,
+    0xec90ca77UL, 0x61e55a6aUL, 0xb3fc9bb6UL, 0xc117c465UL, 0x130e05b9UL,
+    0x24c17bc3UL, 0xf6d8ba1fUL, 0x8433e5ccUL, 0x562a2410UL, 0xebad1938UL,
+    0x39b4d8e4UL, 0x4b5f8737UL, 0x994646ebUL, 0xae893891UL, 0x7c90f94dUL,
+    0x0e7ba69eUL, 0xdc626742UL, 0x71b4c179UL, 0xa3ad00a5UL, 0xd1465f76UL,
+    0x035f9eaaUL, 0x3490e0d0UL, 0xe689210cUL, 0x94627edfUL, 0x467bbf03UL,
+    0xfbfc822bUL, 0x29e543f7UL, 0x5b0e1c24UL, 0x8917ddf8UL, 0xbed8a382UL,
+    0x6cc1625eUL, 0x1e2a3d8dUL, 0xcc33fc51UL, 0x828cd898UL, 0x50951944UL,
+    0x227e4697UL, 0xf067874bUL, 0xc7a8f931UL, 0x15b138edUL, 0x675a673eUL,
+    0xb543a6e2UL, 0x08c49bcaUL, 0xdadd5a16UL, 0xa83605c5UL, 0x7a2fc419UL,
+    0x4de0ba63UL, 0x9ff97bbfUL, 0xed12246cUL, 0x3f0be5b0UL, 0x92dd438bUL,
+    0x40c48257UL, 0x322fdd84UL, 0xe0361c58UL, 0xd7f96222UL, 0x05e0a3feUL,
+    0x770bfc2dUL, 0xa5123df1UL, 0x189500d9UL, 0xca8cc105UL, 0xb8679ed6UL,
+    0x6a7e5f0aUL, 0x5db12170UL, 0x8fa8e0acUL, 0xfd43bf7fUL, 0x2f5a7ea3UL,
+    0xa22feebeUL, 0x70362f62UL, 0x02dd70b1UL, 0xd0c4b16dUL, 0xe70bcf17UL,
+    0x35120ecbUL, 0x47f95118UL, 0x95e090c4UL, 0x2867adecUL, 0xfa7e6c30UL,
+    0x889533e3UL, 0x5a8cf23fUL, 0x6d438c45UL, 0xbf5a4d99UL, 0xcdb1124aUL,
+    0x1fa8d396UL, 0xb27e75adUL, 0x6067b471UL, 0x128ceba2UL, 0xc0952a7eUL,
+    0xf75a5404UL, 0x254395d8UL, 0x57a8ca0bUL, 0x85b10bd7UL, 0x383636ffUL,
+    0xea2ff723UL, 0x98c4a8f0UL, 0x4add692cUL, 0x7d121756UL, 0xaf0bd68aUL,
+    0xdde08959UL, 0x0ff94885UL, 0xc3cab4d4UL, 0x11d37508UL, 0x63382adbUL,
+    0xb121eb07UL, 0x86ee957dUL, 0x54f754a1UL, 0x261c0b72UL, 0xf405caaeUL,
+    0x4982f786UL, 0x9b9b365aUL, 0xe9706989UL, 0x3b69a855UL, 0x0ca6d62fUL,
+    0xdebf17f3UL, 0xac544820UL, 0x7e4d89fcUL, 0xd39b2fc7UL, 0x0182ee1bUL,
+    0x7369b1c8UL, 0xa1707014UL, 0x96bf0e6eUL, 0x44a6cfb2UL, 0x364d9061UL,
+    0xe45451bdUL, 0x59d36c95UL, 0x8bcaad49UL, 0xf921f29aUL, 0x2b383346UL,
+    0x1cf74d3cUL, 0xceee8ce0UL, 0xbc05d333UL, 0x6e1c12efUL, 0xe36982f2UL,
+    0x3170432eUL, 0x439b1cfdUL, 0x9182dd21UL, 0xa64da35bUL, 0x74546287UL,
+    0x06bf3d54UL, 0xd4a6fc88UL, 0x6921c1a0UL, 0xbb38007cUL, 0xc9d35fafUL,
+    0x1bca9e73UL, 0x2c05e009UL, 0xfe1c21d5UL, 0x8cf77e06UL, 0x5eeebfdaUL,
+    0xf33819e1UL, 0x2121d83dUL, 0x53ca87eeUL, 0x81d34632UL, 0xb61c3848UL,
+    0x6405f994UL, 0x16eea647UL, 0xc4f7679bUL, 0x79705ab3UL, 0xab699b6fUL,
+    0xd982c4bcUL, 0x0b9b0560UL, 0x3c547b1aUL, 0xee4dbac6UL, 0x9ca6e515UL,
+    0x4ebf24c9UL
+  },
+  {
+    0x00000000UL, 0x01d8ac87UL, 0x03b1590eUL, 0x0269f589UL, 0x0762b21cUL,
+    0x06ba1e9bUL, 0x04d3eb12UL, 0x050b4795UL, 0x0ec56438UL, 0x0f1dc8bfUL,
+    0x0d743d36UL, 0x0cac91b1UL, 0x09a7d624UL, 0x087f7aa3UL, 0x0a168f2aUL,
+    0x0bce23adUL, 0x1d8ac870UL, 0x1c5264f7UL, 0x1e3b917eUL, 0x1fe33df9UL,
+    0x1ae87a6cUL, 0x1b30d6ebUL, 0x19592362UL, 0x18818fe5UL, 0x134fac48UL,
+    0x129700cfUL, 0x10fef546UL, 0x112659c1UL, 0x142d1e54UL, 0x15f5b2d3UL,
+    0x179c475aUL, 0x1644ebddUL, 0x3b1590e0UL, 0x3acd3c67UL, 0x38a4c9eeUL,
+    0x397c6569UL, 0x3c7722fcUL, 0x3daf8e7bUL, 0x3fc67bf2UL, 0x3e1ed775UL,
+    0x35d0f4d8UL, 0x3408585fUL, 0x3661add6UL, 0x37b90151UL, 0x32b246c4UL,
+    0x336aea43UL, 0x31031fcaUL, 0x30dbb34dUL, 0x269f5890UL, 0x2747f417UL,
+    0x252e019eUL, 0x24f6ad19UL, 0x21fdea8cUL, 0x2025460bUL, 0x224cb382UL,
+    0x23941f05UL, 0x285a3ca8UL, 0x2982902fUL, 0x2beb65a6UL, 0x2a33c921UL,
+    0x2f388eb4UL, 0x2ee02233UL, 0x2c89d7baUL, 0x2d517b3dUL, 0x762b21c0UL,
+    0x77f38d47UL, 0x759a78ceUL, 0x7442d449UL, 0x714993dcUL, 0x70913f5bUL,
+    0x72f8cad2UL, 0x73206655UL, 0x78ee45f8UL, 0x7936e97fUL, 0x7b5f1cf6UL,
+    0x7a87b071UL, 0x7f8cf7e4UL, 0x7e545b63UL, 0x7c3daeeaUL, 0x7de5026dUL,
+    0x6ba1e9b0UL, 0x6a794537UL, 0x6810b0beUL, 0x69c81c39UL, 0x6cc35bacUL,
+    0x6d1bf72bUL, 0x6f7202a2UL, 0x6eaaae25UL, 0x65648d88UL, 0x64bc210fUL,
+    0x66d5d486UL, 0x670d7801UL, 0x62063f94UL, 0x63de9313UL, 0x61b7669aUL,
+    0x606fca1dUL, 0x4d3eb120UL, 0x4ce61da7UL, 0x4e8fe82eUL, 0x4f5744a9UL,
+    0x4a5c033cUL, 0x4b84afbbUL, 0x49ed5a32UL, 0x4835f6b5UL, 0x43fbd518UL,
+    0x4223799fUL, 0x404a8c16UL, 0x41922091UL, 0x44996704UL, 0x4541cb83UL,
+    0x47283e0aUL, 0x46f0928dUL, 0x50b47950UL, 0x516cd5d7UL, 0x5305205eUL,
+    0x52dd8cd9UL, 0x57d6cb4cUL, 0x560e67cbUL, 0x54679242UL, 0x55bf3ec5UL,
+    0x5e711d68UL, 0x5fa9b1efUL, 0x5dc04466UL, 0x5c18e8e1UL, 0x5913af74UL,
+    0x58cb03f3UL, 0x5aa2f67aUL, 0x5b7a5afdUL, 0xec564380UL, 0xed8eef07UL,
+    0xefe71a8eUL, 0xee3fb609UL, 0xeb34f19cUL, 0xeaec5d1bUL, 0xe885a892UL,
+    0xe95d0415UL, 0xe29327b8UL, 0xe34b8b3fUL, 0xe1227eb6UL, 0xe0fad231UL,
+    0xe5f195a4UL, 0xe4293923UL, 0xe640ccaaUL, 0xe798602dUL, 0xf1dc8bf0UL,
+    0xf0042777UL, 0xf26dd2feUL, 0xf3b57e79UL, 0xf6be39ecUL, 0xf766956bUL,
+    0xf50f60e2UL, 0xf4d7cc65UL, 0xff19efc8UL, 0xfec1434fUL, 0xfca8b6c6UL,
+    0xfd701a41UL, 0xf87b5dd4UL, 0xf9a3f153UL, 0xfbca04daUL, 0xfa12a85dUL,
+    0xd743d360UL, 0xd69b7fe7UL, 0xd4f28a6eUL, 0xd52a26e9UL, 0xd021617cUL,
+    0xd1f9cdfbUL, 0xd3903872UL, 0xd24894f5UL, 0xd986b758UL, 0xd85e1bdfUL,
+    0xda37ee56UL, 0xdbef42d1UL, 0xdee40544UL, 0xdf3ca9c3UL, 0xdd555c4aUL,
+    0xdc8df0cdUL, 0xcac91b10UL, 0xcb11b797UL, 0xc978421eUL, 0xc8a0ee99UL,
+    0xcdaba90cUL, 0xcc73058bUL, 0xce1af002UL, 0xcfc25c85UL, 0xc40c7f28UL,
+    0xc5d4d3afUL, 0xc7bd2626UL, 0xc6658aa1UL, 0xc36ecd34UL, 0xc2b661b3UL,
+    0xc0df943aUL, 0xc10738bdUL, 0x9a7d6240UL, 0x9ba5cec7UL, 0x99cc3b4eUL,
+    0x981497c9UL, 0x9d1fd05cUL, 0x9cc77cdbUL, 0x9eae8952UL, 0x9f7625d5UL,
+    0x94b80678UL, 0x9560aaffUL, 0x97095f76UL, 0x96d1f3f1UL, 0x93dab464UL,
+    0x920218e3UL, 0x906bed6aUL, 0x91b341edUL, 0x87f7aa30UL, 0x862f06b7UL,
+    0x8446f33eUL, 0x859e5fb9UL, 0x8095182cUL, 0x814db4abUL, 0x83244122UL,
+    0x82fceda5UL, 0x8932ce08UL, 0x88ea628fUL, 0x8a839706UL, 0x8b5b3b81UL,
+    0x8e507c14UL, 0x8f88d093UL, 0x8de1251aUL, 0x8c39899dUL, 0xa168f2a0UL,
+    0xa0b05e27UL, 0xa2d9abaeUL, 0xa3010729UL, 0xa60a40bcUL, 0xa7d2ec3bUL,
+    0xa5bb19b2UL, 0xa463b535UL, 0xafad9698UL, 0xae753a1fUL, 0xac1ccf96UL,
+    0xadc46311UL, 0xa8cf2484UL, 0xa9178803UL, 0xab7e7d8aUL, 0xaaa6d10dUL,
+    0xbce23ad0UL, 0xbd3a9657UL, 0xbf5363deUL, 0xbe8bcf59UL, 0xbb8088ccUL,
+    0xba58244bUL, 0xb831d1c2UL, 0xb9e97d45UL, 0xb2275ee8UL, 0xb3fff26fUL,
+    0xb19607e6UL, 0xb04eab61UL, 0xb545ecf4UL, 0xb49d4073UL, 0xb6f4b5faUL,
+    0xb72c197dUL
+  },
+  {
+    0x00000000UL, 0xdc6d9ab7UL, 0xbc1a28d9UL, 0x6077b26eUL, 0x7cf54c05UL,
+    0xa098d6b2UL, 0xc0ef64dcUL, 0x1c82fe6bUL, 0xf9ea980aUL, 0x258702bdUL,
+    0x45f0b0d3UL, 0x999d2a64UL, 0x851fd40fUL, 0x59724eb8UL, 0x3905fcd6UL,
+    0xe5686661UL, 0xf7142da3UL, 0x2b79b714UL, 0x4b0e057aUL, 0x97639fcdUL,
+    0x8be161a6UL, 0x578cfb11UL, 0x37fb497fUL, 0xeb96d3c8UL, 0x0efeb5a9UL,
+    0xd2932f1eUL, 0xb2e49d70UL, 0x6e8907c7UL, 0x720bf9acUL, 0xae66631bUL,
+    0xce11d175UL, 0x127c4bc2UL, 0xeae946f1UL, 0x3684dc46UL, 0x56f36e28UL,
+    0x8a9ef49fUL, 0x961c0af4UL, 0x4a719043UL, 0x2a06222dUL, 0xf66bb89aUL,
+    0x1303defbUL, 0xcf6e444cUL, 0xaf19f622UL, 0x73746c95UL, 0x6ff692feUL,
+    0xb39b0849UL, 0xd3ecba27UL, 0x0f812090UL, 0x1dfd6b52UL, 0xc190f1e5UL,
+    0xa1e7438bUL, 0x7d8ad93cUL, 0x61082757UL, 0xbd65bde0UL, 0xdd120f8eUL,
+    0x017f9539UL, 0xe417f358UL, 0x387a69efUL, 0x580ddb81UL, 0x84604136UL,
+    0x98e2bf5dUL, 0x448f25eaUL, 0x24f89784UL, 0xf8950d33UL, 0xd1139055UL,
+    0x0d7e0ae2UL, 0x6d09b88cUL, 0xb164223bUL, 0xade6dc50UL, 0x718b46e7UL,
+    0x11fcf489UL, 0xcd916e3eUL, 0x28f9085fUL, 0xf49492e8UL, 0x94e32086UL,
+    0x488eba31UL, 0x540c445aUL, 0x8861deedUL, 0xe8166c83UL, 0x347bf634UL,
+    0x2607bdf6UL, 0xfa6a2741UL, 0x9a1d952fUL, 0x46700f98UL, 0x5af2f1f3UL,
+    0x869f6b44UL, 0xe6e8d92aUL, 0x3a85439dUL, 0xdfed25fcUL, 0x0380bf4bUL,
+    0x63f70d25UL, 0xbf9a9792UL, 0xa31869f9UL, 0x7f75f34eUL, 0x1f024120UL,
+    0xc36fdb97UL, 0x3bfad6a4UL, 0xe7974c13UL, 0x87e0fe7dUL, 0x5b8d64caUL,
+    0x470f9aa1UL, 0x9b620016UL, 0xfb15b278UL, 0x277828cfUL, 0xc2104eaeUL,
+    0x1e7dd419UL, 0x7e0a6677UL, 0xa267fcc0UL, 0xbee502abUL, 0x6288981cUL,
+    0x02ff2a72UL, 0xde92b0c5UL, 0xcceefb07UL, 0x108361b0UL, 0x70f4d3deUL,
+    0xac994969UL, 0xb01bb702UL, 0x6c762db5UL, 0x0c019fdbUL, 0xd06c056cUL,
+    0x3504630dUL, 0xe969f9baUL, 0x891e4bd4UL, 0x5573d163UL, 0x49f12f08UL,
+    0x959cb5bfUL, 0xf5eb07d1UL, 0x29869d66UL, 0xa6e63d1dUL, 0x7a8ba7aaUL,
+    0x1afc15c4UL, 0xc6918f73UL, 0xda137118UL, 0x067eebafUL, 0x660959c1UL,
+    0xba64c376UL, 0x5f0ca517UL, 0x83613fa0UL, 0xe3168dceUL, 0x3f7b1779UL,
+    0x23f9e912UL, 0xff9473a5UL, 0x9fe3c1cbUL, 0x438e5b7cUL, 0x51f210beUL,
+    0x8d9f8a09UL, 0xede83867UL, 0x3185a2d0UL, 0x2d075cbbUL, 0xf16ac60cUL,
+    0x911d7462UL, 0x4d70eed5UL, 0xa81888b4UL, 0x74751203UL, 0x1402a06dUL,
+    0xc86f3adaUL, 0xd4edc4b1UL, 0x08805e06UL, 0x68f7ec68UL, 0xb49a76dfUL,
+    0x4c0f7becUL, 0x9062e15bUL, 0xf0155335UL, 0x2c78c982UL, 0x30fa37e9UL,
+    0xec97ad5eUL, 0x8ce01f30UL, 0x508d8587UL, 0xb5e5e3e6UL, 0x69887951UL,
+    0x09ffcb3fUL, 0xd5925188UL, 0xc910afe3UL, 0x157d3554UL, 0x750a873aUL,
+    0xa9671d8dUL, 0xbb1b564fUL, 0x6776ccf8UL, 0x07017e96UL, 0xdb6ce421UL,
+    0xc7ee1a4aUL, 0x1b8380fdUL, 0x7bf43293UL, 0xa799a824UL, 0x42f1ce45UL,
+    0x9e9c54f2UL, 0xfeebe69cUL, 0x22867c2bUL, 0x3e048240UL, 0xe26918f7UL,
+    0x821eaa99UL, 0x5e73302eUL, 0x77f5ad48UL, 0xab9837ffUL, 0xcbef8591UL,
+    0x17821f26UL, 0x0b00e14dUL, 0xd76d7bfaUL, 0xb71ac994UL, 0x6b775323UL,
+    0x8e1f3542UL, 0x5272aff5UL, 0x32051d9bUL, 0xee68872cUL, 0xf2ea7947UL,
+    0x2e87e3f0UL, 0x4ef0519eUL, 0x929dcb29UL, 0x80e180ebUL, 0x5c8c1a5cUL,
+    0x3cfba832UL, 0xe0963285UL, 0xfc14cceeUL, 0x20795659UL, 0x400ee437UL,
+    0x9c637e80UL, 0x790b18e1UL, 0xa5668256UL, 0xc5113038UL, 0x197caa8fUL,
+    0x05fe54e4UL, 0xd993ce53UL, 0xb9e47c3dUL, 0x6589e68aUL, 0x9d1cebb9UL,
+    0x4171710eUL, 0x2106c360UL, 0xfd6b59d7UL, 0xe1e9a7bcUL, 0x3d843d0bUL,
+    0x5df38f65UL, 0x819e15d2UL, 0x64f673b3UL, 0xb89be904UL, 0xd8ec5b6aUL,
+    0x0481c1ddUL, 0x18033fb6UL, 0xc46ea501UL, 0xa419176fUL, 0x78748dd8UL,
+    0x6a08c61aUL, 0xb6655cadUL, 0xd612eec3UL, 0x0a7f7474UL, 0x16fd8a1fUL,
+    0xca9010a8UL, 0xaae7a2c6UL, 0x768a3871UL, 0x93e25e10UL, 0x4f8fc4a7UL,
+    0x2ff876c9UL, 0xf395ec7eUL, 0xef171215UL, 0x337a88a2UL, 0x530d3accUL,
+    0x8f60a07bUL
+  },
+  {
+    0x00000000UL, 0x490d678dUL, 0x921acf1aUL, 0xdb17a897UL, 0x20f48383UL,
+    0x69f9e40eUL, 0xb2ee4c99UL, 0xfbe32b14UL, 0x41e90706UL, 0x08e4608bUL,
+    0xd3f3c81cUL, 0x9afeaf91UL, 0x611d8485UL, 0x2810e308UL, 0xf3074b9fUL,
+    0xba0a2c12UL, 0x83d20e0cUL, 0xcadf6981UL, 0x11c8c116UL, 0x58c5a69bUL,
+    0xa3268d8fUL, 0xea2bea02UL, 0x313c4295UL, 0x78312518UL, 0xc23b090aUL,
+    0x8b366e87UL, 0x5021c610UL, 0x192ca19dUL, 0xe2cf8a89UL, 0xabc2ed04UL,
+    0x70d54593UL, 0x39d8221eUL, 0x036501afUL, 0x4a686622UL, 0x917fceb5UL,
+    0xd872a938UL, 0x2391822cUL, 0x6a9ce5a1UL, 0xb18b4d36UL, 0xf8862abbUL,
+    0x428c06a9UL, 0x0b816124UL, 0xd096c9b3UL, 0x999bae3eUL, 0x6278852aUL,
+    0x2b75e2a7UL, 0xf0624a30UL, 0xb96f2dbdUL, 0x80b70fa3UL, 0xc9ba682eUL,
+    0x12adc0b9UL, 0x5ba0a734UL, 0xa0438c20UL, 0xe94eebadUL, 0x3259433aUL,
+    0x7b5424b7UL, 0xc15e08a5UL, 0x88536f28UL, 0x5344c7bfUL, 0x1a49a032UL,
+    0xe1aa8b26UL, 0xa8a7ecabUL, 0x73b0443cUL, 0x3abd23b1UL, 0x06ca035eUL,
+    0x4fc764d3UL, 0x94d0cc44UL, 0xddddabc9UL, 0x263e80ddUL, 0x6f33e750UL,
+    0xb4244fc7UL, 0xfd29284aUL, 0x47230458UL, 0x0e2e63d5UL, 0xd539cb42UL,
+    0x9c34accfUL, 0x67d787dbUL, 0x2edae056UL, 0xf5cd48c1UL, 0xbcc02f4cUL,
+    0x85180d52UL, 0xcc156adfUL, 0x1702c248UL, 0x5e0fa5c5UL, 0xa5ec8ed1UL,
+    0xece1e95cUL, 0x37f641cbUL, 0x7efb2646UL, 0xc4f10a54UL, 0x8dfc6dd9UL,
+    0x56ebc54eUL, 0x1fe6a2c3UL, 0xe40589d7UL, 0xad08ee5aUL, 0x761f46cdUL,
+    0x3f122140UL, 0x05af02f1UL, 0x4ca2657cUL, 0x97b5cdebUL, 0xdeb8aa66UL,
+    0x255b8172UL, 0x6c56e6ffUL, 0xb7414e68UL, 0xfe4c29e5UL, 0x444605f7UL,
+    0x0d4b627aUL, 0xd65ccaedUL, 0x9f51ad60UL, 0x64b28674UL, 0x2dbfe1f9UL,
+    0xf6a8496eUL, 0xbfa52ee3UL, 0x867d0cfdUL, 0xcf706b70UL, 0x1467c3e7UL,
+    0x5d6aa46aUL, 0xa6898f7eUL, 0xef84e8f3UL, 0x34934064UL, 0x7d9e27e9UL,
+    0xc7940bfbUL, 0x8e996c76UL, 0x558ec4e1UL, 0x1c83a36cUL, 0xe7608878UL,
+    0xae6deff5UL, 0x757a4762UL, 0x3c7720efUL, 0x0d9406bcUL, 0x44996131UL,
+    0x9f8ec9a6UL, 0xd683ae2bUL, 0x2d60853fUL, 0x646de2b2UL, 0xbf7a4a25UL,
+    0xf6772da8UL, 0x4c7d01baUL, 0x05706637UL, 0xde67cea0UL, 0x976aa92dUL,
+    0x6c898239UL, 0x2584e5b4UL, 0xfe934d23UL, 0xb79e2aaeUL, 0x8e4608b0UL,
+    0xc74b6f3dUL, 0x1c5cc7aaUL, 0x5551a027UL, 0xaeb28b33UL, 0xe7bfecbeUL,
+    0x3ca84429UL, 0x75a523a4UL, 0xcfaf0fb6UL, 0x86a2683bUL, 0x5db5c0acUL,
+    0x14b8a721UL, 0xef5b8c35UL, 0xa656ebb8UL, 0x7d41432fUL, 0x344c24a2UL,
+    0x0ef10713UL, 0x47fc609eUL, 0x9cebc809UL, 0xd5e6af84UL, 0x2e058490UL,
+    0x6708e31dUL, 0xbc1f4b8aUL, 0xf5122c07UL, 0x4f180015UL, 0x06156798UL,
+    0xdd02cf0fUL, 0x940fa882UL, 0x6fec8396UL, 0x26e1e41bUL, 0xfdf64c8cUL,
+    0xb4fb2b01UL, 0x8d23091fUL, 0xc42e6e92UL, 0x1f39c605UL, 0x5634a188UL,
+    0xadd78a9cUL, 0xe4daed11UL, 0x3fcd4586UL, 0x76c0220bUL, 0xccca0e19UL,
+    0x85c76994UL, 0x5ed0c103UL, 0x17dda68eUL, 0xec3e8d9aUL, 0xa533ea17UL,
+    0x7e244280UL, 0x3729250dUL, 0x0b5e05e2UL, 0x4253626fUL, 0x9944caf8UL,
+    0xd049ad75UL, 0x2baa8661UL, 0x62a7e1ecUL, 0xb9b0497bUL, 0xf0bd2ef6UL,
+    0x4ab702e4UL, 0x03ba6569UL, 0xd8adcdfeUL, 0x91a0aa73UL, 0x6a438167UL,
+    0x234ee6eaUL, 0xf8594e7dUL, 0xb15429f0UL, 0x888c0beeUL, 0xc1816c63UL,
+    0x1a96c4f4UL, 0x539ba379UL, 0xa878886dUL, 0xe175efe0UL, 0x3a624777UL,
+    0x736f20faUL, 0xc9650ce8UL, 0x80686b65UL, 0x5b7fc3f2UL, 0x1272a47fUL,
+    0xe9918f6bUL, 0xa09ce8e6UL, 0x7b8b4071UL, 0x328627fcUL, 0x083b044dUL,
+    0x413663c0UL, 0x9a21cb57UL, 0xd32cacdaUL, 0x28cf87ceUL, 0x61c2e043UL,
+    0xbad548d4UL, 0xf3d82f59UL, 0x49d2034bUL, 0x00df64c6UL, 0xdbc8cc51UL,
+    0x92c5abdcUL, 0x692680c8UL, 0x202be745UL, 0xfb3c4fd2UL, 0xb231285fUL,
+    0x8be90a41UL, 0xc2e46dccUL, 0x19f3c55bUL, 0x50fea2d6UL, 0xab1d89c2UL,
+    0xe210ee4fUL, 0x390746d8UL, 0x700a2155UL, 0xca000d47UL, 0x830d6acaUL,
+    0x581ac25dUL, 0x1117a5d0UL, 0xeaf48ec4UL, 0xa3f9e949UL, 0x78ee41deUL,
+    0x31e32653UL
+  },
+  {
+    0x00000000UL, 0x1b280d78UL, 0x36501af0UL, 0x2d781788UL, 0x6ca035e0UL,
+    0x77883898UL, 0x5af02f10UL, 0x41d82268UL, 0xd9406bc0UL, 0xc26866b8UL,
+    0xef107130UL, 0xf4387c48UL, 0xb5e05e20UL, 0xaec85358UL, 0x83b044d0UL,
+    0x989849a8UL, 0xb641ca37UL, 0xad69c74fUL, 0x8011d0c7UL, 0x9b39ddbfUL,
+    0xdae1ffd7UL, 0xc1c9f2afUL, 0xecb1e527UL, 0xf799e85fUL, 0x6f01a1f7UL,
+    0x7429ac8fUL, 0x5951bb07UL, 0x4279b67fUL, 0x03a19417UL, 0x1889996fUL,
+    0x35f18ee7UL, 0x2ed9839fUL, 0x684289d9UL, 0x736a84a1UL, 0x5e129329UL,
+    0x453a9e51UL, 0x04e2bc39UL, 0x1fcab141UL, 0x32b2a6c9UL, 0x299aabb1UL,
+    0xb102e219UL, 0xaa2aef61UL, 0x8752f8e9UL, 0x9c7af591UL, 0xdda2d7f9UL,
+    0xc68ada81UL, 0xebf2cd09UL, 0xf0dac071UL, 0xde0343eeUL, 0xc52b4e96UL,
+    0xe853591eUL, 0xf37b5466UL, 0xb2a3760eUL, 0xa98b7b76UL, 0x84f36cfeUL,
+    0x9fdb6186UL, 0x0743282eUL, 0x1c6b2556UL, 0x311332deUL, 0x2a3b3fa6UL,
+    0x6be31dceUL, 0x70cb10b6UL, 0x5db3073eUL, 0x469b0a46UL, 0xd08513b2UL,
+    0xcbad1ecaUL, 0xe6d50942UL, 0xfdfd043aUL, 0xbc252652UL, 0xa70d2b2aUL,
+    0x8a753ca2UL, 0x915d31daUL, 0x09c57872UL, 0x12ed750aUL, 0x3f956282UL,
+    0x24bd6ffaUL, 0x65654d92UL, 0x7e4d40eaUL, 0x53355762UL, 0x481d5a1aUL,
+    0x66c4d985UL, 0x7decd4fdUL, 0x5094c375UL, 0x4bbcce0dUL, 0x0a64ec65UL,
+    0x114ce11dUL, 0x3c34f695UL, 0x271cfbedUL, 0xbf84b245UL, 0xa4acbf3dUL,
+    0x89d4a8b5UL, 0x92fca5cdUL, 0xd32487a5UL, 0xc80c8addUL, 0xe5749d55UL,
+    0xfe5c902dUL, 0xb8c79a6bUL, 0xa3ef9713UL, 0x8e97809bUL, 0x95bf8de3UL,
+    0xd467af8bUL, 0xcf4fa2f3UL, 0xe237b57bUL, 0xf91fb803UL, 0x6187f1abUL,
+    0x7aaffcd3UL, 0x57d7eb5bUL, 0x4cffe623UL, 0x0d27c44bUL, 0x160fc933UL,
+    0x3b77debbUL, 0x205fd3c3UL, 0x0e86505cUL, 0x15ae5d24UL, 0x38d64aacUL,
+    0x23fe47d4UL, 0x622665bcUL, 0x790e68c4UL, 0x54767f4cUL, 0x4f5e7234UL,
+    0xd7c63b9cUL, 0xccee36e4UL, 0xe196216cUL, 0xfabe2c14UL, 0xbb660e7cUL,
+    0xa04e0304UL, 0x8d36148cUL, 0x961e19f4UL, 0xa5cb3ad3UL, 0xbee337abUL,
+    0x939b2023UL, 0x88b32d5bUL, 0xc96b0f33UL, 0xd243024bUL, 0xff3b15c3UL,
+    0xe41318bbUL, 0x7c8b5113UL, 0x67a35c6bUL, 0x4adb4be3UL, 0x51f3469bUL,
+    0x102b64f3UL, 0x0b03698bUL, 0x267b7e03UL, 0x3d53737bUL, 0x138af0e4UL,
+    0x08a2fd9cUL, 0x25daea14UL, 0x3ef2e76cUL, 0x7f2ac504UL, 0x6402c87cUL,
+    0x497adff4UL, 0x5252d28cUL, 0xcaca9b24UL, 0xd1e2965cUL, 0xfc9a81d4UL,
+    0xe7b28cacUL, 0xa66aaec4UL, 0xbd42a3bcUL, 0x903ab434UL, 0x8b12b94cUL,
+    0xcd89b30aUL, 0xd6a1be72UL, 0xfbd9a9faUL, 0xe0f1a482UL, 0xa12986eaUL,
+    0xba018b92UL, 0x97799c1aUL, 0x8c519162UL, 0x14c9d8caUL, 0x0fe1d5b2UL,
+    0x2299c23aUL, 0x39b1cf42UL, 0x7869ed2aUL, 0x6341e052UL, 0x4e39f7daUL,
+    0x5511faa2UL, 0x7bc8793dUL, 0x60e07445UL, 0x4d9863cdUL, 0x56b06eb5UL,
+    0x17684cddUL, 0x0c4041a5UL, 0x2138562dUL, 0x3a105b55UL, 0xa28812fdUL,
+    0xb9a01f85UL, 0x94d8080dUL, 0x8ff00575UL, 0xce28271dUL, 0xd5002a65UL,
+    0xf8783dedUL, 0xe3503095UL, 0x754e2961UL, 0x6e662419UL, 0x431e3391UL,
+    0x58363ee9UL, 0x19ee1c81UL, 0x02c611f9UL, 0x2fbe0671UL, 0x34960b09UL,
+    0xac0e42a1UL, 0xb7264fd9UL, 0x9a5e5851UL, 0x81765529UL, 0xc0ae7741UL,
+    0xdb867a39UL, 0xf6fe6db1UL, 0xedd660c9UL, 0xc30fe356UL, 0xd827ee2eUL,
+    0xf55ff9a6UL, 0xee77f4deUL, 0xafafd6b6UL, 0xb487dbceUL, 0x99ffcc46UL,
+    0x82d7c13eUL, 0x1a4f8896UL, 0x016785eeUL, 0x2c1f9266UL, 0x37379f1eUL,
+    0x76efbd76UL, 0x6dc7b00eUL, 0x40bfa786UL, 0x5b97aafeUL, 0x1d0ca0b8UL,
+    0x0624adc0UL, 0x2b5cba48UL, 0x3074b730UL, 0x71ac9558UL, 0x6a849820UL,
+    0x47fc8fa8UL, 0x5cd482d0UL, 0xc44ccb78UL, 0xdf64c600UL, 0xf21cd188UL,
+    0xe934dcf0UL, 0xa8ecfe98UL, 0xb3c4f3e0UL, 0x9ebce468UL, 0x8594e910UL,
+    0xab4d6a8fUL, 0xb06567f7UL, 0x9d1d707fUL, 0x86357d07UL, 0xc7ed5f6fUL,
+    0xdcc55217UL, 0xf1bd459fUL, 0xea9548e7UL, 0x720d014fUL, 0x69250c37UL,
+    0x445d1bbfUL, 0x5f7516c7UL, 0x1ead34afUL, 0x058539d7UL, 0x28fd2e5fUL,
+    0x33d52327UL
+  },
+  {
+    0x00000000UL, 0x4f576811UL, 0x9eaed022UL, 0xd1f9b833UL, 0x399cbdf3UL,
+    0x76cbd5e2UL, 0xa7326dd1UL, 0xe86505c0UL, 0x73397be6UL, 0x3c6e13f7UL,
+    0xed97abc4UL, 0xa2c0c3d5UL, 0x4aa5c615UL, 0x05f2ae04UL, 0xd40b1637UL,
+    0x9b5c7e26UL, 0xe672f7ccUL, 0xa9259fddUL, 0x78dc27eeUL, 0x378b4fffUL,
+    0xdfee4a3fUL, 0x90b9222eUL, 0x41409a1dUL, 0x0e17f20cUL, 0x954b8c2aUL,
+    0xda1ce43bUL, 0x0be55c08UL, 0x44b23419UL, 0xacd731d9UL, 0xe38059c8UL,
+    0x3279e1fbUL, 0x7d2e89eaUL, 0xc824f22fUL, 0x87739a3eUL, 0x568a220dUL,
+    0x19dd4a1cUL, 0xf1b84fdcUL, 0xbeef27cdUL, 0x6f169ffeUL, 0x2041f7efUL,
+    0xbb1d89c9UL, 0xf44ae1d8UL, 0x25b359ebUL, 0x6ae431faUL, 0x8281343aUL,
+    0xcdd65c2bUL, 0x1c2fe418UL, 0x53788c09UL, 0x2e5605e3UL, 0x61016df2UL,
+    0xb0f8d5c1UL, 0xffafbdd0UL, 0x17cab810UL, 0x589dd001UL, 0x89646832UL,
+    0xc6330023UL, 0x5d6f7e05UL, 0x12381614UL, 0xc3c1ae27UL, 0x8c96c636UL,
+    0x64f3c3f6UL, 0x2ba4abe7UL, 0xfa5d13d4UL, 0xb50a7bc5UL, 0x9488f9e9UL,
+    0xdbdf91f8UL, 0x0a2629cbUL, 0x457141daUL, 0xad14441aUL, 0xe2432c0bUL,
+    0x33ba9438UL, 0x7cedfc29UL, 0xe7b1820fUL, 0xa8e6ea1eUL, 0x791f522dUL,
+    0x36483a3cUL, 0xde2d3ffcUL, 0x917a57edUL, 0x4083efdeUL, 0x0fd487cfUL,
+    0x72fa0e25UL, 0x3dad6634UL, 0xec54de07UL, 0xa303b616UL, 0x4b66b3d6UL,
+    0x0431dbc7UL, 0xd5c863f4UL, 0x9a9f0be5UL, 0x01c375c3UL, 0x4e941dd2UL,
+    0x9f6da5e1UL, 0xd03acdf0UL, 0x385fc830UL, 0x7708a021UL, 0xa6f11812UL,
+    0xe9a67003UL, 0x5cac0bc6UL, 0x13fb63d7UL, 0xc202dbe4UL, 0x8d55b3f5UL,
+    0x6530b635UL, 0x2a67de24UL, 0xfb9e6617UL, 0xb4c90e06UL, 0x2f957020UL,
+    0x60c21831UL, 0xb13ba002UL, 0xfe6cc813UL, 0x1609cdd3UL, 0x595ea5c2UL,
+    0x88a71df1UL, 0xc7f075e0UL, 0xbadefc0aUL, 0xf589941bUL, 0x24702c28UL,
+    0x6b274439UL, 0x834241f9UL, 0xcc1529e8UL, 0x1dec91dbUL, 0x52bbf9caUL,
+    0xc9e787ecUL, 0x86b0effdUL, 0x574957ceUL, 0x181e3fdfUL, 0xf07b3a1fUL,
+    0xbf2c520eUL, 0x6ed5ea3dUL, 0x2182822cUL, 0x2dd0ee65UL, 0x62878674UL,
+    0xb37e3e47UL, 0xfc295656UL, 0x144c5396UL, 0x5b1b3b87UL, 0x8ae283b4UL,
+    0xc5b5eba5UL, 0x5ee99583UL, 0x11befd92UL, 0xc04745a1UL, 0x8f102db0UL,
+    0x67752870UL, 0x28224061UL, 0xf9dbf852UL, 0xb68c9043UL, 0xcba219a9UL,
+    0x84f571b8UL, 0x550cc98bUL, 0x1a5ba19aUL, 0xf23ea45aUL, 0xbd69cc4bUL,
+    0x6c907478UL, 0x23c71c69UL, 0xb89b624fUL, 0xf7cc0a5eUL, 0x2635b26dUL,
+    0x6962da7cUL, 0x8107dfbcUL, 0xce50b7adUL, 0x1fa90f9eUL, 0x50fe678fUL,
+    0xe5f41c4aUL, 0xaaa3745bUL, 0x7b5acc68UL, 0x340da479UL, 0xdc68a1b9UL,
+    0x933fc9a8UL, 0x42c6719bUL, 0x0d91198aUL, 0x96cd67acUL, 0xd99a0fbdUL,
+    0x0863b78eUL, 0x4734df9fUL, 0xaf51da5fUL, 0xe006b24eUL, 0x31ff0a7dUL,
+    0x7ea8626cUL, 0x0386eb86UL, 0x4cd18397UL, 0x9d283ba4UL, 0xd27f53b5UL,
+    0x3a1a5675UL, 0x754d3e64UL, 0xa4b48657UL, 0xebe3ee46UL, 0x70bf9060UL,
+    0x3fe8f871UL, 0xee114042UL, 0xa1462853UL, 0x49232d93UL, 0x06744582UL,
+    0xd78dfdb1UL, 0x98da95a0UL, 0xb958178cUL, 0xf60f7f9dUL, 0x27f6c7aeUL,
+    0x68a1afbfUL, 0x80c4aa7fUL, 0xcf93c26eUL, 0x1e6a7a5dUL, 0x513d124cUL,
+    0xca616c6aUL, 0x8536047bUL, 0x54cfbc48UL, 0x1b98d459UL, 0xf3fdd199UL,
+    0xbcaab988UL, 0x6d5301bbUL, 0x220469aaUL, 0x5f2ae040UL, 0x107d8851UL,
+    0xc1843062UL, 0x8ed35873UL, 0x66b65db3UL, 0x29e135a2UL, 0xf8188d91UL,
+    0xb74fe580UL, 0x2c139ba6UL, 0x6344f3b7UL, 0xb2bd4b84UL, 0xfdea2395UL,
+    0x158f2655UL, 0x5ad84e44UL, 0x8b21f677UL, 0xc4769e66UL, 0x717ce5a3UL,
+    0x3e2b8db2UL, 0xefd23581UL, 0xa0855d90UL, 0x48e05850UL, 0x07b73041UL,
+    0xd64e8872UL, 0x9919e063UL, 0x02459e45UL, 0x4d12f654UL, 0x9ceb4e67UL,
+    0xd3bc2676UL, 0x3bd923b6UL, 0x748e4ba7UL, 0xa577f394UL, 0xea209b85UL,
+    0x970e126fUL, 0xd8597a7eUL, 0x09a0c24dUL, 0x46f7aa5cUL, 0xae92af9cUL,
+    0xe1c5c78dUL, 0x303c7fbeUL, 0x7f6b17afUL, 0xe4376989UL, 0xab600198UL,
+    0x7a99b9abUL, 0x35ced1baUL, 0xddabd47aUL, 0x92fcbc6bUL, 0x43050458UL,
+    0x0c526c49UL
+  },
+  {
+    0x00000000UL, 0x5ba1dccaUL, 0xb743b994UL, 0xece2655eUL, 0x6a466e9fUL,
+    0x31e7b255UL, 0xdd05d70bUL, 0x86a40bc1UL, 0xd48cdd3eUL, 0x8f2d01f4UL,
+    0x63cf64aaUL, 0x386eb860UL, 0xbecab3a1UL, 0xe56b6f6bUL, 0x09890a35UL,
+    0x5228d6ffUL, 0xadd8a7cbUL, 0xf6797b01UL, 0x1a9b1e5fUL, 0x413ac295UL,
+    0xc79ec954UL, 0x9c3f159eUL, 0x70dd70c0UL, 0x2b7cac0aUL, 0x79547af5UL,
+    0x22f5a63fUL, 0xce17c361UL, 0x95b61fabUL, 0x1312146aUL, 0x48b3c8a0UL,
+    0xa451adfeUL, 0xfff07134UL, 0x5f705221UL, 0x04d18eebUL, 0xe833ebb5UL,
+    0xb392377fUL, 0x35363cbeUL, 0x6e97e074UL, 0x8275852aUL, 0xd9d459e0UL,
+    0x8bfc8f1fUL, 0xd05d53d5UL, 0x3cbf368bUL, 0x671eea41UL, 0xe1bae180UL,
+    0xba1b3d4aUL, 0x56f95814UL, 0x0d5884deUL, 0xf2a8f5eaUL, 0xa9092920UL,
+    0x45eb4c7eUL, 0x1e4a90b4UL, 0x98ee9b75UL, 0xc34f47bfUL, 0x2fad22e1UL,
+    0x740cfe2bUL, 0x262428d4UL, 0x7d85f41eUL, 0x91679140UL, 0xcac64d8aUL,
+    0x4c62464bUL, 0x17c39a81UL, 0xfb21ffdfUL, 0xa0802315UL, 0xbee0a442UL,
+    0xe5417888UL, 0x09a31dd6UL, 0x5202c11cUL, 0xd4a6caddUL, 0x8f071617UL,
+    0x63e57349UL, 0x3844af83UL, 0x6a6c797cUL, 0x31cda5b6UL, 0xdd2fc0e8UL,
+    0x868e1c22UL, 0x002a17e3UL, 0x5b8bcb29UL, 0xb769ae77UL, 0xecc872bdUL,
+    0x13380389UL, 0x4899df43UL, 0xa47bba1dUL, 0xffda66d7UL, 0x797e6d16UL,
+    0x22dfb1dcUL, 0xce3dd482UL, 0x959c0848UL, 0xc7b4deb7UL, 0x9c15027dUL,
+    0x70f76723UL, 0x2b56bbe9UL, 0xadf2b028UL, 0xf6536ce2UL, 0x1ab109bcUL,
+    0x4110d576UL, 0xe190f663UL, 0xba312aa9UL, 0x56d34ff7UL, 0x0d72933dUL,
+    0x8bd698fcUL, 0xd0774436UL, 0x3c952168UL, 0x6734fda2UL, 0x351c2b5dUL,
+    0x6ebdf797UL, 0x825f92c9UL, 0xd9fe4e03UL, 0x5f5a45c2UL, 0x04fb9908UL,
+    0xe819fc56UL, 0xb3b8209cUL, 0x4c4851a8UL, 0x17e98d62UL, 0xfb0be83cUL,
+    0xa0aa34f6UL, 0x260e3f37UL, 0x7dafe3fdUL, 0x914d86a3UL, 0xcaec5a69UL,
+    0x98c48c96UL, 0xc365505cUL, 0x2f873502UL, 0x7426e9c8UL, 0xf282e209UL,
+    0xa9233ec3UL, 0x45c15b9dUL, 0x1e608757UL, 0x79005533UL, 0x22a189f9UL,
+    0xce43eca7UL, 0x95e2306dUL, 0x13463bacUL, 0x48e7e766UL, 0xa4058238UL,
+    0xffa45ef2UL, 0xad8c880dUL, 0xf62d54c7UL, 0x1acf3199UL, 0x416eed53UL,
+    0xc7cae692UL, 0x9c6b3a58UL, 0x70895f06UL, 0x2b2883ccUL, 0xd4d8f2f8UL,
+    0x8f792e32UL, 0x639b4b6cUL, 0x383a97a6UL, 0xbe9e9c67UL, 0xe53f40adUL,
+    0x09dd25f3UL, 0x527cf939UL, 0x00542fc6UL, 0x5bf5f30cUL, 0xb7179652UL,
+    0xecb64a98UL, 0x6a124159UL, 0x31b39d93UL, 0xdd51f8cdUL, 0x86f02407UL,
+    0x26700712UL, 0x7dd1dbd8UL, 0x9133be86UL, 0xca92624cUL, 0x4c36698dUL,
+    0x1797b547UL, 0xfb75d019UL, 0xa0d40cd3UL, 0xf2fcda2cUL, 0xa95d06e6UL,
+    0x45bf63b8UL, 0x1e1ebf72UL, 0x98bab4b3UL, 0xc31b6879UL, 0x2ff90d27UL,
+    0x7458d1edUL, 0x8ba8a0d9UL, 0xd0097c13UL, 0x3ceb194dUL, 0x674ac587UL,
+    0xe1eece46UL, 0xba4f128cUL, 0x56ad77d2UL, 0x0d0cab18UL, 0x5f247de7UL,
+    0x0485a12dUL, 0xe867c473UL, 0xb3c618b9UL, 0x35621378UL, 0x6ec3cfb2UL,
+    0x8221aaecUL, 0xd9807626UL, 0xc7e0f171UL, 0x9c412dbbUL, 0x70a348e5UL,
+    0x2b02942fUL, 0xada69feeUL, 0xf6074324UL, 0x1ae5267aUL, 0x4144fab0UL,
+    0x136c2c4fUL, 0x48cdf085UL, 0xa42f95dbUL, 0xff8e4911UL, 0x792a42d0UL,
+    0x228b9e1aUL, 0xce69fb44UL, 0x95c8278eUL, 0x6a3856baUL, 0x31998a70UL,
+    0xdd7bef2eUL, 0x86da33e4UL, 0x007e3825UL, 0x5bdfe4efUL, 0xb73d81b1UL,
+    0xec9c5d7bUL, 0xbeb48b84UL, 0xe515574eUL, 0x09f73210UL, 0x5256eedaUL,
+    0xd4f2e51bUL, 0x8f5339d1UL, 0x63b15c8fUL, 0x38108045UL, 0x9890a350UL,
+    0xc3317f9aUL, 0x2fd31ac4UL, 0x7472c60eUL, 0xf2d6cdcfUL, 0xa9771105UL,
+    0x4595745bUL, 0x1e34a891UL, 0x4c1c7e6eUL, 0x17bda2a4UL, 0xfb5fc7faUL,
+    0xa0fe1b30UL, 0x265a10f1UL, 0x7dfbcc3bUL, 0x9119a965UL, 0xcab875afUL,
+    0x3548049bUL, 0x6ee9d851UL, 0x820bbd0fUL, 0xd9aa61c5UL, 0x5f0e6a04UL,
+    0x04afb6ceUL, 0xe84dd390UL, 0xb3ec0f5aUL, 0xe1c4d9a5UL, 0xba65056fUL,
+    0x56876031UL, 0x0d26bcfbUL, 0x8b82b73aUL, 0xd0236bf0UL, 0x3cc10eaeUL,
+    0x6760d264UL
+  }
+};
@@ -0,0 +1,155 @@
+#if !defined(__CWSLOT_H__)
+#define __CWSLOT_H__
+
+/* Shared memory control word slot, daemon to plugin.
+ *
+ * One slot per device, in a POSIX shared memory segment named
+ * "/cwdwgw.cw<device>", holding the last even/odd control words, the
+ * service they are for and the time they were written, on the monotonic
+ * clock both processes share. The daemon is the only writer; the plugin polls
+ * the sequence counter from its packet thread, a single load when nothing
+ * changed. A sequence lock keeps the reader from seeing half a write:
+ * the counter is odd while the daemon writes, a reader retries when it
+ * reads an odd value or the counter moved under it.
+ *
+ * The same file is in cwdwplug and eyetvCamd. */
+
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sched.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdint.h>
+#if defined(__APPLE__)
+#include <mach/mach_time.h>
+#else
+#include <time.h>
+#endif
+
+#define CWSLOT_MAGIC  0x43575333  // 'CWS3'
+
+typedef struct
+{
+  uint32_t magic;
+  volatile uint32_t seq;        // odd while being written
+  unsigned char dw[16];         // even cw, odd cw
+  uint64_t stamp;               // write time, cwSlotNow()
+  uint32_t service;             // EyeTV service id
+} cwSlotShared;
+
+typedef struct
+{
+  cwSlotShared *shm;
+} cwSlot;
+
+// microseconds of the monotonic clock, since boot; the plugin's coarseTick is this / 1000
+static inline uint64_t cwSlotNow(void)
+{
+#if defined(__APPLE__)
+  static mach_timebase_info_data_t timebase;
+  if( timebase.denom == 0 )
+    mach_timebase_info(&timebase);
+  return mach_absolute_time() * timebase.numer / timebase.denom / 1000;
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#endif
+}
+
+static inline void cwSlotClose(cwSlot *c)
+{
+  if( c->shm != NULL )
+    munmap(c->shm, sizeof(cwSlotShared));
+  c->shm = NULL;
+}
+
+/* Maps the device's slot, creating it if need be. A segment with another
+ * magic was left by a build with another layout: it is logged, unlinked and
+ * made anew. Whoever still has the old one mapped keeps it until it opens
+ * the slot again. */
+static inline bool cwSlotOpen(cwSlot *c, int devIndex)
+{
+  char name[32];
+  struct stat st;
+  void *p;
+  int fd;
+
+  c->shm = NULL;
+  snprintf(name, sizeof(name), "/cwdwgw.cw%d", devIndex);
+  for(int attempt = 0; attempt < 2; attempt++)
+  {
+    fd = shm_open(name, O_RDWR | O_CREAT, 0600);
+    if( fd < 0 )
+      return false;
+    // the size can be set once only on some systems, which round it up
+    if( fstat(fd, &st) != 0 || (st.st_size < (off_t)sizeof(cwSlotShared) && ftruncate(fd, sizeof(cwSlotShared)) != 0) )
+    {
+      close(fd);
+      return false;
+    }
+    p = mmap(NULL, sizeof(cwSlotShared), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if( p == MAP_FAILED )
+      return false;
+    c->shm = (cwSlotShared *)p;
+    __sync_bool_compare_and_swap(&c->shm->magic, 0, CWSLOT_MAGIC);
+    uint32_t magic = c->shm->magic;
+    if( magic == CWSLOT_MAGIC )
+      return true;
+    fprintf(stderr, "cwslot: %s has magic 0x%08x instead of 0x%08x, %s\n", name, magic, CWSLOT_MAGIC,
+	    attempt == 0 ? "making it anew" : "giving up");
+    cwSlotClose(c);
+    if( attempt == 0 && shm_unlink(name) != 0 )
+      return false;
+  }
+  return false;
+}
+
+//----- writer, the daemon
+
+static inline void cwSlotWrite(cwSlot *c, const unsigned char *dw, uint32_t service)
+{
+  cwSlotShared *s = c->shm;
+  uint32_t seq = s->seq;
+  s->seq = seq + 1;
+  __sync_synchronize();   // odd counter visible before the words change
+  memcpy(s->dw, dw, 16);
+  s->stamp = cwSlotNow();
+  s->service = service;
+  __sync_synchronize();   // words complete before the counter is even again
+  s->seq = seq + 2;
+}
+
+//----- reader, the plugin
+
+// the counter to compare with the last one read, cheap enough for every packet callback
+static inline uint32_t cwSlotSequence(cwSlot *c)
+{
+  return c->shm->seq;
+}
+
+// a consistent copy of the slot, returns its sequence counter
+static inline uint32_t cwSlotRead(cwSlot *c, unsigned char *dw, uint64_t *stamp, uint32_t *service)
+{
+  cwSlotShared *s = c->shm;
+  uint32_t seq;
+  for(;;)
+  {
+    seq = __sync_fetch_and_add(&s->seq, 0);
+    if( (seq & 1) == 0 )
+    {
+      memcpy(dw, s->dw, 16);
+      *stamp = s->stamp;
+      *service = s->service;
+      if( __sync_fetch_and_add(&s->seq, 0) == seq )
+        return seq;
+    }
+    sched_yield();
+  }
+}
+
+#endif
@@ -18,7 +18,7 @@ typedef enum
 
 - (id)init;
 - (void)dealloc;
-- (void)parseCATPayload:(NSData *)packet;
+- (void)parseCATPayload:(const unsigned char *)packet length:(unsigned int)length;
 - (bool)parseCaDescriptor:(Descriptor *)caDesc;
 - (NSArray *)getCaDescriptors;
 - (int)caDescCount;
@@ -1,5 +1,6 @@
 #import "emm.h"
 #import "globals.h"
+#include "crc32.h"
 
 @implementation cat
 
@@ -35,18 +36,18 @@
     [caList removeAllObjects];
 }
 
-- (void)parseCATPayload:(NSData *)packet
+- (void)parseCATPayload:(const unsigned char *)packet length:(unsigned int)length
 {
     [caList removeAllObjects];
     if( getEmmDebug() == TRUE )
     {
         ControllerLog("CAT Received:------------\n");
-        ControllerDump(packet);
+        ControllerDump((unsigned char *)packet, length);
         ControllerLog("--------------------------------\n");
     }
     unsigned int curOffset = 8; // skip header 
-    unsigned int curMaxLen = [packet length]  - 4 /* CRC32 */;
-    unsigned char *pData = (unsigned char *)[packet bytes];
+    unsigned int curMaxLen = length  - 4 /* CRC32 */;
+    unsigned char *pData = (unsigned char *)packet;
     Descriptor *descs = (Descriptor *)(pData + curOffset);
     do
     {
@@ -126,7 +127,6 @@
 
 @end
 
-extern "C" unsigned long crc32(unsigned long, void *, unsigned int );
 @implementation emmParams
 
 - (id)initWithSerial:(unsigned char *)sn provData:(unsigned char *)pd caid:(unsigned int)casys ident:(unsigned int)provid
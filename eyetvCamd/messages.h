@@ -41,6 +41,7 @@ typedef struct
 {
   msg_type id;
   unsigned char dw[16];
+  unsigned long mService;   // the EyeTV service the words are for
 } newDw;
 
 typedef struct
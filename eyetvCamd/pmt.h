@@ -89,7 +89,7 @@ struct esdescr
 
 - (id)init;
 - (void)dealloc;
-- (void)parsePmtPayload:(NSData *)packet;
+- (void)parsePmtPayload:(const unsigned char *)packet length:(unsigned int)length;
 - (void)parseCaDescriptor:(Descriptor *)caDesc;
 - (NSArray *)getCaDescriptors;
 - (int)caDescCount;
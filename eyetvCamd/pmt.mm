@@ -1,5 +1,5 @@
 #import "pmt.h"
-extern "C" unsigned long crc32(unsigned long, void *, unsigned int );
+#include "crc32.h"
 @implementation caDescriptor
 - (id) initStaticWithEcmpid:(unsigned int)pid casys:(unsigned int)ca ident:(unsigned int)provid
 {
@@ -200,12 +200,12 @@ extern "C" unsigned long crc32(unsigned long, void *, unsigned int );
   }
 }
 
-- (void)parsePmtPayload:(NSData *)packet
+- (void)parsePmtPayload:(const unsigned char *)packet length:(unsigned int)length
 {
   [caList removeAllObjects];
   unsigned int curOffset = 0;
-  unsigned int curMaxLen = [packet length]  - 4 /* CRC32 */;
-  unsigned char *pData = (unsigned char *)[packet bytes];
+  unsigned int curMaxLen = length  - 4 /* CRC32 */;
+  unsigned char *pData = (unsigned char *)packet;
   
   int cahdLen = ((pData[10] & 0xf) << 8) | (pData[11] & 0xff);
   curOffset += 12;
@@ -1,34 +1,79 @@
-#import <Cocoa/Cocoa.h>
+#if !defined(__SECTIONFILTER_H__)
+#define __SECTIONFILTER_H__
 
-typedef enum
+/* Section assembler, one per PID.
+ *
+ * Collects the PSI/private sections (PMT, CAT, ECM, EMM) of a PID from its
+ * TS packets in a fixed buffer, without allocating: the pointer_field of a
+ * unit start ends the section in progress and starts the next one, a packet
+ * may hold several sections and a section may span packets. Complete
+ * sections are handed out as views into the buffer, valid up to the next
+ * toStream or reset:
+ *
+ *   if( s.toStream(pkt, &info) )
+ *     while( s.nextSection(&v) )
+ *       ...
+ *
+ * A continuity error or a broken packet drops the section in progress, the
+ * assembler then waits for the next unit start. It has no constructor, so
+ * it can live in plain structs; init it before use. */
+
+#include "tsbatch.h"
+
+#define SECTION_MAX     4096                  // the longest section
+#define SECTION_BUFFER  (SECTION_MAX + 184)   // and the rest of the packet it ends in
+
+typedef struct
 {
-  stateNone,
-  stateBeginPayloadFound,
-  statePayloadFull
-} payloadStates;
+  const unsigned char *data;
+  unsigned int length;
+} sectionView;
 
-@interface section: NSObject
+class sectionAssembler
 {
-@protected
+public:
+  void init(unsigned int _pid);
+  // drops what is buffered, the next section starts at a unit start
+  void reset();
+  unsigned int getPid() const { return pid; }
+  /* Feeds a packet as tsClassify found it. A packet of another PID starts
+   * over with that PID. True when complete sections are there to read. */
+  bool toStream(const unsigned char *packet, const tsPacketInfo *info);
+  // the next complete section; false when there is none (yet)
+  bool nextSection(sectionView *view);
+
+private:
+  unsigned int completeEnd() const;
+  void append(const unsigned char *bytes, int len);
+
   unsigned int pid;
-  unsigned int CC;
-  NSMutableData *pidBytes;
-  NSData *sectionBytes;
-  payloadStates state;
-  int sectionOffset;
-}
-
-- (unsigned int)hash;
-- (bool)isEqual:(id)anObj;
-- (payloadStates) toStream:(unsigned char *)buffer;
-- (id) initWithPid:(unsigned int)_pid;
-- (void) dealloc;
-- (unsigned int) getPid;
-- (void) setPid:(unsigned int) _pid;
-- (unsigned char *) getBuffer;
-- (NSData *) getData;
-- (void) reset;
-- (BOOL) nextSection;
-
-@end
+  int cc;                 // continuity counter of the last packet, -1 none yet
+  int lastLen;            // its payload, to know a duplicate by
+  unsigned char last[184];
+  bool collecting;        // inside a unit, after its start
+  unsigned int length;    // bytes in buffer
+  unsigned int read;      // the next section to hand out
+  unsigned char buffer[SECTION_BUFFER];
+};
+
+/* The last section of a table that was taken, known by table_id, the
+ * table_id_extension (program_number of a PMT), version_number,
+ * section_number and CRC_32. A section repeated unchanged costs one
+ * comparison; a changed one has its CRC checked before it is taken.
+ * Like sectionAssembler it has no constructor; reset it before use. */
+class sectionVersion
+{
+public:
+  void reset() { valid = false; }
+  /* True when the section is intact, applicable (current_next_indicator)
+   * and differs from the one taken before, which it then replaces. */
+  bool changed(const sectionView *view);
+
+private:
+  bool valid;
+  uint32_t id;            // table_id, extension, section_number
+  uint32_t crc;
+  uint8_t version;
+};
 
+#endif
@@ -1,189 +1,171 @@
-#import "sectionFilter.h"
-#include "dvbheader.h"
+#include "sectionFilter.h"
 #include "globals.h"
+#include "crc32.h"
+#include <string.h>
 
-static inline int payload(const unsigned char *tsp)
+static inline unsigned int sectionLength(const unsigned char *s)
 {
-  TSHeader hdr;
-  hdr.word = ntohl(*(unsigned int *)tsp);
-  int pOffset = 0, pLen = 184;
-  
-  if( hdr.ts.transportErr != 0 ) return -1;
-  switch( hdr.ts.adaption )
-  {
-    case 1: 
-      break;    // payload only
-    case 2: 
-      return 0; // no payload
-    case 3: 
-      pOffset = 1 + tsp[4];
-      pLen -= pOffset;
-      break;
-    default:
-      return -1;
-  }
-  if( hdr.ts.payloadStart != 0 ) 
-  {
-    int additional = tsp[4 + pOffset] + 1;
-    pOffset += additional;
-    pLen -= additional;
-  }
-  if( pOffset < 0 || pLen < 0 ) 
-  {
-    return -1;
-  }
-  if( (pOffset + pLen) != 184) 
-  {
-    return -1;
-  }
-  return pLen;
+  return (((s[1] & 0xf) << 8) | s[2]) + 3;
 }
 
-@implementation section
+void sectionAssembler::init(unsigned int _pid)
+{
+  pid = _pid;
+  cc = -1;
+  lastLen = 0;
+  reset();
+}
 
-- (unsigned int)hash
+void sectionAssembler::reset()
 {
-  return pid;
+  collecting = false;
+  length = 0;
+  read = 0;
 }
 
-- (bool)isEqual:(id)anObj
+// the end of the complete sections from read on
+unsigned int sectionAssembler::completeEnd() const
 {
-  return pid == [anObj getPid];
+  unsigned int end = read;
+  while( length - end >= 3 && buffer[end] != 0xff && end + sectionLength(buffer + end) <= length )
+  {
+    end += sectionLength(buffer + end);
+  }
+  return end;
 }
 
-- (payloadStates) toStream:(unsigned char *)buffer
+void sectionAssembler::append(const unsigned char *bytes, int len)
 {
-  if( state == statePayloadFull )
+  if( len <= 0 )
+    return;
+  if( (unsigned int)len > SECTION_BUFFER - length )
   {
-    return stateNone;
+    /* what fits may still end a section, the section after it is cut off:
+     * up to the next unit start */
+    memcpy(buffer + length, bytes, SECTION_BUFFER - length);
+    length = SECTION_BUFFER;
+    length = completeEnd();
+    collecting = false;
+    return;
   }
-  TSHeader rcv;
-  int payloadLen = payload(buffer);
-  unsigned int offset = 188 - payloadLen;
-  rcv.word = ntohl(*(unsigned int *)buffer);
-  if( rcv.ts.pid != pid )
+  memcpy(buffer + length, bytes, len);
+  length += len;
+}
+
+bool sectionAssembler::toStream(const unsigned char *packet, const tsPacketInfo *info)
+{
+  if( info->pid != pid )
   {
-    pid = rcv.ts.pid;
-    [self reset];
+    pid = info->pid;
+    cc = -1;
+    reset();
   }
-  if( state == stateBeginPayloadFound && rcv.ts.payloadStart != 0 )
+  // the sections handed out are done with
+  if( read != 0 )
   {
-    [self reset];
+    memmove(buffer, buffer + read, length - read);
+    length -= read;
+    read = 0;
   }
-  if( state == stateNone && rcv.ts.payloadStart != 0 )
+  if( info->payloadLen < 0 )
   {
-    if( payloadLen > 0 )
-    {
-      CC = rcv.ts.continuity & 0xf;
-      state = stateBeginPayloadFound;
-      [pidBytes setLength:0];
-      [pidBytes appendBytes:(buffer + offset) length:payloadLen];
-    }
-  } 
-  else if( state == stateBeginPayloadFound && rcv.ts.payloadStart == 0 )
+    reset();
+    return false;
+  }
+  if( (info->flags & TS_PAYLOAD) == 0 )
   {
-    if( payloadLen > 0 )
+    return length > 0 && completeEnd() > 0;   // adaptation field only, the counter stays
+  }
+  bool start = (info->flags & TS_START) != 0;
+  // a packet sent twice has the same counter and the same bytes (13818-1 2.4.3.3)
+  if( start == false && collecting && info->continuity == cc && info->payloadLen == lastLen &&
+      memcmp(packet + info->payload, last, lastLen) == 0 )
+  {
+    return completeEnd() > 0;
+  }
+  if( collecting && info->continuity != ((cc + 1) & 0xf) )
+  {
+    // the plugin's section gate leaves out repeated units, a gap before a unit start is no error
+    if( start == false )
+      ControllerLog("section filter: PID 0x%x: Continuity Indicator failed: expected %d, received %d\n", pid, (cc + 1) & 0xf, info->continuity);
+    reset();
+  }
+  cc = info->continuity;
+  lastLen = info->payloadLen;
+  memcpy(last, packet + info->payload, lastLen);
+
+  if( info->flags & TS_START )
+  {
+    if( info->payloadLen == 0 )
     {
-      unsigned int nextCC = rcv.ts.continuity & 0xf;
-      int expectedCC = CC + 1;
-      if( expectedCC == 16 )
-	expectedCC = 0;
-      if( nextCC == expectedCC )
-      {
-	CC = expectedCC;
-	[pidBytes appendBytes:(buffer + offset) length:payloadLen];
-      }
-      else 
-      {
-	[self reset];
-	ControllerLog("section filter: PID 0x%x: Continuity Indicator failed: expected %d, received %d\n", pid, CC+1, nextCC);
-      }
+      reset();
+      return false;
     }
-    else
+    if( collecting )
     {
-      [self reset];
+      // the bytes the pointer_field skips end the section in progress
+      int raw = (info->flags & TS_ADAPTATION) ? 5 + packet[4] : 4;
+      append(packet + raw + 1, info->payload - raw - 1);
     }
+    // what isn't a complete section by now never will be
+    length = completeEnd();
+    collecting = true;
+    append(packet + info->payload, info->payloadLen);
   }
-  if( state == stateBeginPayloadFound )
+  else if( collecting )
   {
-    unsigned char *sectionData = (unsigned char *)[pidBytes bytes];
-    unsigned int sectionLen = (((sectionData[1] & 0xf) << 8) | sectionData[2]) + 3;
-    if( sectionLen <= [pidBytes length] )
-    {
-      sectionBytes = [[NSData alloc] initWithBytes:sectionData length:sectionLen];
-      state = statePayloadFull;
-    }
+    append(packet + info->payload, info->payloadLen);
   }
-  return state;
-}
-
-- (BOOL) nextSection
-{
-  if( sectionBytes != 0 )
+  unsigned int end = completeEnd();
+  if( collecting && end < length && buffer[end] == 0xff )
   {
-    sectionOffset += [sectionBytes length];
-    unsigned char *sectionData = (unsigned char *)[pidBytes bytes] + sectionOffset;
-    unsigned int sectionLen = (((sectionData[1] & 0xf) << 8) | sectionData[2]) + 3;
-    if( sectionData[0] != 0xff && ( sectionOffset + sectionLen ) <= [pidBytes length] )
-    {
-      [sectionBytes release];
-      sectionBytes = [[NSData alloc] initWithBytes:sectionData length:sectionLen];
-      return YES;
-    }
+    // stuffing, the rest of the unit is empty
+    length = end;
+    collecting = false;
   }
-  return NO;
-}
-
-- (id) initWithPid:(unsigned int)_pid
-{
-  self = [super init];
-  if( self != nil )
+  else if( collecting && length - end >= 3 && sectionLength(buffer + end) > SECTION_MAX )
   {
-    state = stateNone;
-    CC = 0;
-    pidBytes = [[NSMutableData alloc] initWithCapacity:512];
-    sectionBytes = nil;
-    sectionOffset = 0;
-	pid = _pid;
+    length = end;
+    collecting = false;
   }
-  return self;
-}
-
-- (void) dealloc
-{
-  [pidBytes release];
-  [super dealloc];
-}
-
-- (unsigned int) getPid
-{
-  return pid;
-}
-
-- (void) setPid:(unsigned int) _pid
-{
-  pid = _pid;
+  return end > read;
 }
 
-- (unsigned char *) getBuffer
+bool sectionAssembler::nextSection(sectionView *view)
 {
-  return (unsigned char *)[sectionBytes bytes];
+  if( length - read < 3 || buffer[read] == 0xff )
+    return false;
+  unsigned int len = sectionLength(buffer + read);
+  if( read + len > length )
+    return false;
+  view->data = buffer + read;
+  view->length = len;
+  read += len;
+  return true;
 }
 
-- (NSData *) getData
+bool sectionVersion::changed(const sectionView *view)
 {
-  return sectionBytes;
-}
+  const unsigned char *s = view->data;
+  unsigned int len = view->length;
 
-- (void) reset
-{
-  state = stateNone;
-  sectionOffset = 0;
-  if( sectionBytes != 0 )
+  if( len < 12 || (s[1] & 0x80) == 0 )    // no long form header and CRC
+    return false;
+  uint32_t sectionId = (uint32_t)s[0] << 24 | s[3] << 16 | s[4] << 8 | s[6];
+  uint32_t sectionCrc = (uint32_t)s[len - 4] << 24 | s[len - 3] << 16 | s[len - 2] << 8 | s[len - 1];
+  uint8_t sectionVer = (s[5] >> 1) & 0x1f;
+  if( valid && sectionCrc == crc && sectionId == id && sectionVer == version )
+    return false;
+  if( (s[5] & 0x01) == 0 )                // not applicable yet
+    return false;
+  if( !crc32SectionValid(s, len) )
   {
-    [sectionBytes release];
-    sectionBytes = 0;
+    ControllerLog("section filter: table 0x%x: CRC failed\n", s[0]);
+    return false;
   }
+  valid = true;
+  id = sectionId;
+  crc = sectionCrc;
+  version = sectionVer;
+  return true;
 }
-
-@end
@@ -0,0 +1,167 @@
+#if !defined(__TSRING_H__)
+#define __TSRING_H__
+
+/* Shared memory transport from the plugin to the daemon.
+ *
+ * One single producer / single consumer ring per device, in a POSIX shared
+ * memory segment named "/cwdwgw.ring<device>". The plugin's packet thread
+ * pushes raw TS packets (and the small control messages of messages.h) into
+ * it, the daemon has one thread per device draining it. When that thread
+ * runs out of work it flags the ring and sleeps on the ring's semaphore
+ * "/cwdwgw.wake<device>"; a producer only posts it when it sees the flag,
+ * so a busy daemon costs no system call per packet. Producers on more than
+ * one thread have to serialize their tsringPush calls.
+ *
+ * Either side may come first: both create the segment and the semaphore if
+ * they don't exist yet. The same file is in cwdwplug and eyetvCamd. */
+
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <semaphore.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdint.h>
+
+#define TSRING_MAGIC     0x54535247  // 'TSRG'
+#define TSRING_SLOTS     2048        // power of two
+#define TSRING_DATA      188
+
+typedef struct
+{
+  uint32_t len;
+  unsigned char data[TSRING_DATA];
+} tsringSlot;
+
+typedef struct
+{
+  uint32_t magic;
+  volatile uint32_t sleeping;   // the consumer waits on the semaphore
+  volatile uint32_t dropped;    // pushes refused, ring full
+  char pad0[64 - 3 * sizeof(uint32_t)];
+  volatile uint32_t head;       // next slot to write, moved by the producer only
+  char pad1[64 - sizeof(uint32_t)];
+  volatile uint32_t tail;       // next slot to read, moved by the consumer only
+  char pad2[64 - sizeof(uint32_t)];
+  tsringSlot slot[TSRING_SLOTS];
+} tsringShared;
+
+typedef struct
+{
+  tsringShared *shm;
+  sem_t *wake;
+} tsring;
+
+static inline void tsringClose(tsring *r)
+{
+  if( r->shm != NULL )
+    munmap(r->shm, sizeof(tsringShared));
+  if( r->wake != NULL && r->wake != SEM_FAILED )
+    sem_close(r->wake);
+  r->shm = NULL;
+  r->wake = NULL;
+}
+
+static inline bool tsringOpen(tsring *r, int devIndex)
+{
+  char name[32];
+  struct stat st;
+  void *p;
+  int fd;
+
+  r->shm = NULL;
+  r->wake = NULL;
+  snprintf(name, sizeof(name), "/cwdwgw.ring%d", devIndex);
+  fd = shm_open(name, O_RDWR | O_CREAT, 0600);
+  if( fd < 0 )
+    return false;
+  // the size can be set once only on some systems, which round it up
+  if( fstat(fd, &st) != 0 || (st.st_size < (off_t)sizeof(tsringShared) && ftruncate(fd, sizeof(tsringShared)) != 0) )
+  {
+    close(fd);
+    return false;
+  }
+  p = mmap(NULL, sizeof(tsringShared), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if( p == MAP_FAILED )
+    return false;
+  r->shm = (tsringShared *)p;
+  snprintf(name, sizeof(name), "/cwdwgw.wake%d", devIndex);
+  r->wake = sem_open(name, O_CREAT, 0600, 0);
+  // a new segment is zero filled, whoever comes first stamps it
+  __sync_bool_compare_and_swap(&r->shm->magic, 0, TSRING_MAGIC);
+  if( r->wake == SEM_FAILED || r->shm->magic != TSRING_MAGIC )
+  {
+    tsringClose(r);
+    return false;
+  }
+  return true;
+}
+
+//----- producer side
+
+static inline bool tsringPush(tsring *r, const unsigned char *data, int len)
+{
+  tsringShared *s = r->shm;
+  uint32_t head = s->head;
+  tsringSlot *slot;
+
+  if( len > TSRING_DATA )
+    return false;
+  if( head - __sync_fetch_and_add(&s->tail, 0) >= TSRING_SLOTS )
+  {
+    __sync_fetch_and_add(&s->dropped, 1);
+    return false;
+  }
+  slot = &s->slot[head & (TSRING_SLOTS - 1)];
+  slot->len = len;
+  memcpy(slot->data, data, len);
+  __sync_synchronize();   // the slot is complete before head moves over it
+  s->head = head + 1;
+  __sync_synchronize();   // and head is visible before sleeping is read
+  if( s->sleeping != 0 && __sync_bool_compare_and_swap(&s->sleeping, 1, 0) )
+    sem_post(r->wake);
+  return true;
+}
+
+//----- consumer side
+
+static inline bool tsringPop(tsring *r, tsringSlot *out)
+{
+  tsringShared *s = r->shm;
+  uint32_t tail = s->tail;
+  tsringSlot *slot;
+
+  if( tail == __sync_fetch_and_add(&s->head, 0) )
+    return false;
+  slot = &s->slot[tail & (TSRING_SLOTS - 1)];
+  out->len = slot->len <= TSRING_DATA ? slot->len : TSRING_DATA;
+  memcpy(out->data, slot->data, out->len);
+  __sync_synchronize();   // the slot is read before the producer can reuse it
+  s->tail = tail + 1;
+  return true;
+}
+
+// drop whatever a producer left while nobody was listening
+static inline void tsringFlush(tsring *r)
+{
+  r->shm->tail = __sync_fetch_and_add(&r->shm->head, 0);
+}
+
+/* Call before sleeping on the ring's semaphore: it returns false if the
+ * ring got data meanwhile, then don't sleep. */
+static inline bool tsringArmWakeup(tsring *r)
+{
+  tsringShared *s = r->shm;
+  __sync_fetch_and_or(&s->sleeping, 1);   // full barrier, pairs with tsringPush
+  return s->tail == s->head;
+}
+
+static inline void tsringDisarmWakeup(tsring *r)
+{
+  r->shm->sleeping = 0;
+}
+
+#endif
@@ -1,8 +1,7 @@
 #include <sys/time.h>
 #import "uniproto.h"
 #include <openssl/md5.h>
-
-extern "C" unsigned long crc32(unsigned long, void *, unsigned int );
+#include "crc32.h"
 
 @implementation caFilterEntry
 
@@ -24,6 +24,7 @@
 
 #include "../tools.h"
 #include "../thread.h"
+#include "../../crc32.h"
 
 #include "misc.h"
 
@@ -133,24 +134,10 @@ unsigned char XorSum(const unsigned char *mem, int len)
   return cs;
 }
 
-// crc stuff taken from linux-2.6.0/lib/crc32.c
-/*
- * There are multiple 16-bit CRC polynomials in common use, but this is
- * *the* standard CRC-32 polynomial, first popularized by Ethernet.
- * x^32+x^26+x^23+x^22+x^16+x^12+x^11+x^10+x^8+x^7+x^5+x^4+x^2+x^1+x^0
- */
-#define CRCPOLY_LE 0xedb88320
-
+// zlib's CRC-32 (polynomial 0xedb88320), see crc32.h
 unsigned int crc32_le(unsigned int crc, unsigned char const *p, int len)
 {
-  crc^=0xffffffff; // zlib mod
-  while(len--) {
-    crc^=*p++;
-    for(int i=0; i<8; i++)
-      crc=(crc&1) ? (crc>>1)^CRCPOLY_LE : (crc>>1);
-    }
-  crc^=0xffffffff; // zlib mod
-  return crc;
+  return len>0 ? crc32(crc,p,len) : crc;
 }
 
 // -- cLineBuff -----------------------------------------------------------------